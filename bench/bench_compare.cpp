@@ -0,0 +1,348 @@
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+/**
+ * Сравнение результатов Google Benchmark с сохраненным baseline.
+ *
+ * Каждый бенчмарк запускается с повторами (--benchmark_repetitions), по
+ * повторам считаются медиана и MAD пропускной способности. Регрессия - это
+ * падение медианы больше порога, которое при этом превышает шум обоих
+ * запусков: случайный разброс между прогонами не считается регрессией.
+ */
+
+namespace {
+    // MAD -> оценка стандартного отклонения для нормального распределения
+    constexpr double MAD_TO_SIGMA = 1.4826;
+
+    struct Series {
+        std::string metric;             ///< bytes_per_second, files/s, items_per_second или iterations_per_second
+        std::vector<double> samples;
+        double median = 0.0;
+        double mad = 0.0;
+
+        double sigma() const { return MAD_TO_SIGMA * mad; }
+    };
+
+    struct BenchSet {
+        json context;
+        std::map<std::string, Series> benchmarks;
+    };
+
+    struct CompareOptions {
+        double threshold_percent = 5.0;     ///< Допустимое падение пропускной способности
+        double noise_sigmas = 3.0;          ///< Во сколько раз падение должно превышать шум
+    };
+
+    double median(std::vector<double> values) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+    }
+
+    void summarize(Series& series) {
+        series.median = median(series.samples);
+        std::vector<double> deviations;
+        for (double sample : series.samples) {
+            deviations.push_back(std::fabs(sample - series.median));
+        }
+        series.mad = median(deviations);
+    }
+
+    /**
+     * Пропускная способность одного повтора (чем больше, тем лучше)
+     */
+    bool throughput(const json& entry, std::string& metric, double& value) {
+        for (const char* key : {"bytes_per_second", "files/s", "items_per_second"}) {
+            if (entry.contains(key) && entry[key].is_number()) {
+                metric = key;
+                value = entry[key].get<double>();
+                return true;
+            }
+        }
+        // без счетчиков - обратное время итерации
+        if (entry.contains("real_time") && entry["real_time"].get<double>() > 0) {
+            metric = "iterations_per_second";
+            value = 1.0 / entry["real_time"].get<double>();
+            return true;
+        }
+        return false;
+    }
+
+    bool loadJson(const std::string& path, json& out) {
+        try {
+            std::ifstream file(path);
+            if (!file.is_open()) {
+                std::cerr << "Error: cannot open " << path << std::endl;
+                return false;
+            }
+            file >> out;
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: invalid JSON in " << path << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    /**
+     * Загрузить набор: вывод бенчмарка (--benchmark_format=json) или сохраненный baseline
+     */
+    bool loadSet(const std::string& path, BenchSet& set) {
+        json data;
+        if (!loadJson(path, data)) {
+            return false;
+        }
+
+        try {
+            set.context = data.value("context", json::object());
+            const auto& benchmarks = data.at("benchmarks");
+
+            if (benchmarks.is_object()) {
+                // baseline: {"name": {"metric": ..., "samples": [...]}}
+                for (const auto& [name, item] : benchmarks.items()) {
+                    Series series;
+                    series.metric = item.at("metric").get<std::string>();
+                    series.samples = item.at("samples").get<std::vector<double>>();
+                    summarize(series);
+                    set.benchmarks[name] = std::move(series);
+                }
+                return true;
+            }
+
+            // вывод Google Benchmark: агрегаты (mean, median, stddev) пересчитываются сами
+            for (const auto& entry : benchmarks) {
+                if (entry.value("run_type", "iteration") != "iteration") {
+                    continue;
+                }
+                if (entry.contains("error_occurred") && entry["error_occurred"].get<bool>()) {
+                    continue;
+                }
+                std::string name = entry.value("run_name", entry.value("name", ""));
+                std::string metric;
+                double value = 0.0;
+                if (name.empty() || !throughput(entry, metric, value)) {
+                    continue;
+                }
+                auto& series = set.benchmarks[name];
+                series.metric = metric;
+                series.samples.push_back(value);
+            }
+            for (auto& [name, series] : set.benchmarks) {
+                summarize(series);
+            }
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: unexpected benchmark format in " << path << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    std::string formatRate(double value, const std::string& metric) {
+        const char* units[] = {"", "k", "M", "G", "T"};
+        int unit = 0;
+        while (std::fabs(value) >= 1000.0 && unit < 4) {
+            value /= 1000.0;
+            unit++;
+        }
+        char buf[48];
+        const char* suffix = metric == "bytes_per_second" ? "B/s"
+                           : metric == "files/s" ? "files/s"
+                           : metric == "items_per_second" ? "items/s" : "it/s";
+        std::snprintf(buf, sizeof(buf), "%.2f %s%s", value, units[unit], suffix);
+        return buf;
+    }
+
+    int save(const std::string& run_path, const std::string& baseline_path) {
+        BenchSet set;
+        if (!loadSet(run_path, set)) {
+            return 2;
+        }
+        if (set.benchmarks.empty()) {
+            std::cerr << "Error: no benchmark results in " << run_path << std::endl;
+            return 2;
+        }
+
+        json baseline;
+        baseline["format_version"] = 1;
+        baseline["context"] = set.context;
+        baseline["benchmarks"] = json::object();
+        for (const auto& [name, series] : set.benchmarks) {
+            baseline["benchmarks"][name] = {
+                {"metric", series.metric},
+                {"samples", series.samples},
+                {"median", series.median},
+                {"mad", series.mad}
+            };
+        }
+
+        // запись через временный файл - прерванный запуск не портит baseline
+        std::string tmp_path = baseline_path + ".tmp";
+        {
+            std::ofstream file(tmp_path);
+            file << baseline.dump(2) << "\n";
+            if (!file) {
+                std::cerr << "Error: cannot write " << tmp_path << std::endl;
+                return 2;
+            }
+        }
+        if (std::rename(tmp_path.c_str(), baseline_path.c_str()) != 0) {
+            std::cerr << "Error: cannot replace " << baseline_path << std::endl;
+            return 2;
+        }
+
+        std::cout << "Saved baseline with " << set.benchmarks.size() << " benchmarks to "
+                  << baseline_path << std::endl;
+        return 0;
+    }
+
+    void warnContextMismatch(const json& base, const json& current) {
+        for (const char* key : {"host_name", "num_cpus", "mhz_per_cpu", "library_build_type"}) {
+            if (base.contains(key) && current.contains(key) && base[key] != current[key]) {
+                std::cout << "warning: " << key << " differs (baseline " << base[key].dump()
+                          << ", current " << current[key].dump() << ") - results may not be comparable\n";
+            }
+        }
+    }
+
+    int compare(const std::string& baseline_path, const std::string& run_path,
+                const CompareOptions& options) {
+        BenchSet base;
+        BenchSet current;
+        if (!loadSet(baseline_path, base) || !loadSet(run_path, current)) {
+            return 2;
+        }
+
+        warnContextMismatch(base.context, current.context);
+
+        size_t regressions = 0;
+        size_t improvements = 0;
+        size_t low_samples = 0;
+
+        std::printf("%-58s %16s %16s %9s %8s  %s\n",
+                    "Benchmark", "Baseline", "Current", "Change", "Noise", "Status");
+        for (const auto& [name, cur] : current.benchmarks) {
+            auto it = base.benchmarks.find(name);
+            if (it == base.benchmarks.end()) {
+                std::printf("%-58s %16s %16s %9s %8s  %s\n", name.c_str(), "-",
+                            formatRate(cur.median, cur.metric).c_str(), "", "", "new");
+                continue;
+            }
+            const Series& old = it->second;
+            if (old.metric != cur.metric || old.median <= 0) {
+                std::printf("%-58s %16s %16s %9s %8s  %s\n", name.c_str(), "-", "-", "", "",
+                            "metric changed");
+                continue;
+            }
+
+            double change = (cur.median - old.median) / old.median * 100.0;
+            // шум - разброс обоих запусков; без повторов оценить его нельзя
+            double noise = std::sqrt(old.sigma() * old.sigma() + cur.sigma() * cur.sigma());
+            double noise_percent = noise / old.median * 100.0;
+            bool enough_samples = old.samples.size() >= 3 && cur.samples.size() >= 3;
+            if (!enough_samples) {
+                low_samples++;
+            }
+            bool significant = std::fabs(cur.median - old.median) > options.noise_sigmas * noise;
+
+            const char* status = "ok";
+            if (change < -options.threshold_percent && significant) {
+                status = "REGRESSION";
+                regressions++;
+            } else if (change < -options.threshold_percent) {
+                status = "within noise";
+            } else if (change > options.threshold_percent && significant) {
+                status = "improved";
+                improvements++;
+            }
+
+            std::printf("%-58s %16s %16s %+8.1f%% %7.1f%%  %s\n", name.c_str(),
+                        formatRate(old.median, old.metric).c_str(),
+                        formatRate(cur.median, cur.metric).c_str(),
+                        change, noise_percent, status);
+        }
+        for (const auto& [name, old] : base.benchmarks) {
+            if (!current.benchmarks.count(name)) {
+                std::printf("%-58s %16s %16s %9s %8s  %s\n", name.c_str(),
+                            formatRate(old.median, old.metric).c_str(), "-", "", "", "missing");
+            }
+        }
+
+        std::cout << "\n";
+        if (low_samples > 0) {
+            std::cout << "warning: " << low_samples << " benchmarks have fewer than 3 repetitions, "
+                      << "noise cannot be estimated (use --benchmark_repetitions)\n";
+        }
+        std::cout << "Threshold: " << options.threshold_percent << "% and "
+                  << options.noise_sigmas << " sigma of noise\n";
+        if (regressions > 0) {
+            std::cout << "FAILED: " << regressions << " benchmark(s) regressed" << std::endl;
+            return 1;
+        }
+        std::cout << "PASSED (" << improvements << " improved)" << std::endl;
+        return 0;
+    }
+
+    void printUsage() {
+        std::cout << R"(
+secret_detector_bench_compare - benchmark baseline and regression gate
+
+USAGE:
+    secret_detector_bench_compare save <RUN.json> <BASELINE.json>
+    secret_detector_bench_compare compare <BASELINE.json> <RUN.json> [OPTIONS]
+
+RUN.json is the output of secret_detector_bench --benchmark_format=json
+(or --benchmark_out=<file>), ideally with --benchmark_repetitions=5 or more.
+A saved baseline or another run can be used as BASELINE.json.
+
+COMPARE OPTIONS:
+    --threshold <PERCENT>      Allowed throughput drop (default: 5)
+    --sigmas <NUM>             Drop must also exceed NUM x combined noise (default: 3)
+
+Exit code: 0 - no regressions, 1 - regression detected, 2 - usage or input error.
+)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 2;
+    }
+
+    std::string command = argv[1];
+    if (command == "save" && argc == 4) {
+        return save(argv[2], argv[3]);
+    }
+    if (command == "compare") {
+        CompareOptions options;
+        for (int i = 4; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (arg == "--threshold" && i + 1 < argc) {
+                    options.threshold_percent = std::stod(argv[++i]);
+                } else if (arg == "--sigmas" && i + 1 < argc) {
+                    options.noise_sigmas = std::stod(argv[++i]);
+                } else {
+                    std::cerr << "Error: unknown option " << arg << std::endl;
+                    return 2;
+                }
+            } catch (...) {
+                std::cerr << "Error: invalid value for " << arg << std::endl;
+                return 2;
+            }
+        }
+        return compare(argv[2], argv[3], options);
+    }
+
+    printUsage();
+    return 2;
+}
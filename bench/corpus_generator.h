@@ -0,0 +1,147 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "core/pattern_matcher.h"
+
+using json = nlohmann::json;
+
+/**
+ * @struct CorpusOptions
+ * @brief Параметры синтетического корпуса
+ *
+ * Одинаковые параметры и seed дают побайтно одинаковое дерево.
+ */
+struct CorpusOptions {
+    uint32_t seed = 1;
+    size_t file_count = 500;            ///< Количество файлов (без .gitignore)
+
+    // доли типов файлов (веса, не обязаны давать в сумме 100)
+    unsigned source_weight = 70;        ///< Исходный код и конфиги
+    unsigned minified_weight = 10;      ///< Минифицированный JS (одна длинная строка)
+    unsigned log_weight = 5;            ///< Большие логи
+    unsigned binary_weight = 15;        ///< Бинарные файлы
+
+    size_t source_size_kb = 8;          ///< Средний размер исходника
+    size_t minified_size_kb = 128;      ///< Средний размер минифицированного JS
+    size_t log_size_kb = 1024;          ///< Средний размер лога
+    size_t binary_size_kb = 64;         ///< Средний размер бинарного файла
+
+    size_t max_depth = 4;               ///< Максимальная вложенность директорий
+    size_t secrets_per_pattern = 4;     ///< Находок на каждый паттерн
+};
+
+/**
+ * @struct PlantedSecret
+ * @brief Подложенный секрет и ожидаемая реакция сканера
+ */
+struct PlantedSecret {
+    std::string path;       ///< Путь относительно корня корпуса
+    int line = 0;           ///< Номер строки (1-indexed)
+    std::string pattern;    ///< Паттерн, который должен сработать
+    std::string text;       ///< Подложенный текст
+    std::string expect;     ///< "found", "ignored" (.gitignore) или "skipped" (бинарный файл)
+};
+
+/**
+ * @struct CorpusManifest
+ * @brief Эталон корпуса: параметры генерации и все подложенные секреты
+ */
+struct CorpusManifest {
+    CorpusOptions options;      ///< Параметры, с которыми корпус сгенерирован
+    size_t file_count = 0;
+    uint64_t total_bytes = 0;
+    std::vector<PlantedSecret> secrets;
+
+    json to_json() const;
+    static bool fromJson(const json& j, CorpusManifest& manifest);
+};
+
+/**
+ * @struct CorpusVerification
+ * @brief Сравнение находок сканера с эталоном
+ */
+struct CorpusVerification {
+    size_t expected = 0;    ///< Ожидаемых находок
+    size_t found = 0;       ///< Из них найдено
+    size_t missed = 0;      ///< Ожидаемые, но не найденные
+    size_t leaked = 0;      ///< Найдены в игнорируемых/бинарных файлах
+    size_t extra = 0;       ///< Находки, которых нет в эталоне
+    std::vector<std::string> errors;    ///< Описание пропусков и утечек
+
+    bool passed() const { return missed == 0 && leaked == 0; }
+};
+
+/**
+ * @class CorpusGenerator
+ * @brief Генератор воспроизводимых деревьев для замеров производительности
+ *
+ * Дерево содержит исходники, минифицированный JS, логи, бинарные файлы
+ * и вложенные .gitignore. Для каждого паттерна подкладываются секреты
+ * в сканируемые файлы, а также приманки в игнорируемой директории и в
+ * бинарных файлах, которые сканер находить не должен.
+ */
+class CorpusGenerator {
+public:
+    static constexpr const char* MANIFEST_NAME = "corpus_manifest.json";
+    static constexpr const char* IGNORED_DIR = "ignored_build";
+
+    explicit CorpusGenerator(CorpusOptions options);
+
+    /**
+     * Сгенерировать корпус
+     * @param root Директория (пустая или с предыдущим корпусом - будет очищена)
+     * @param patterns Паттерны, для которых подкладываются секреты
+     * @param manifest Эталон (также пишется в root/corpus_manifest.json)
+     * @return true если успешно; false если для паттерна нет генератора секретов
+     */
+    bool generate(const std::string& root, const std::vector<Pattern>& patterns,
+                  CorpusManifest& manifest);
+
+    /**
+     * Загрузить эталон
+     */
+    static bool loadManifest(const std::string& path, CorpusManifest& manifest);
+
+    /**
+     * Сравнить находки с эталоном
+     * @param manifest Эталон
+     * @param matches Находки сканера
+     * @param root Корень сканирования (для относительных путей)
+     */
+    static CorpusVerification verify(const CorpusManifest& manifest,
+                                     const std::vector<Match>& matches,
+                                     const std::string& root);
+
+    /**
+     * Есть ли генератор секретов для паттерна
+     */
+    static bool canPlant(const std::string& pattern_name);
+
+private:
+    enum class FileKind { Source, Minified, Log, Binary };
+
+    struct FilePlan {
+        std::string path;
+        FileKind kind;
+        size_t size;
+        bool binary_text = false;   ///< .txt с бинарным содержимым (отсекается по содержимому)
+        std::vector<std::pair<std::string, std::string>> secrets;  ///< (паттерн, текст)
+    };
+
+    CorpusOptions options;
+    std::mt19937 rng;
+
+    size_t pick(size_t bound) { return bound ? rng() % bound : 0; }
+    size_t jitter(size_t mean_bytes);
+    std::string randomDir();
+    std::string makeSecret(const std::string& pattern_name);
+
+    std::vector<std::string> makeSourceLines(size_t size, const std::string& ext);
+    std::string makeMinified(size_t size);
+    std::vector<std::string> makeLogLines(size_t size);
+    std::string makeBinary(size_t size);
+};
@@ -0,0 +1,212 @@
+#include "corpus_generator.h"
+#include "core/secret_detector.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+
+namespace {
+    void printUsage() {
+        std::cout << R"(
+secret_detector_corpus - reproducible synthetic corpus for throughput testing
+
+USAGE:
+    secret_detector_corpus generate <DIR> [OPTIONS]
+    secret_detector_corpus verify <DIR> [--report <FILE>] [--threads <NUM>]
+
+GENERATE OPTIONS:
+    --seed <NUM>               Random seed (default: 1)
+    --files <NUM>              Number of files (default: 500)
+    --mix <S,M,L,B>            Weights of source, minified JS, log and binary files
+                               (default: 70,10,5,15)
+    --source-kb <NUM>          Mean source file size in KB (default: 8)
+    --minified-kb <NUM>        Mean minified JS size in KB (default: 128)
+    --log-kb <NUM>             Mean log size in KB (default: 1024)
+    --binary-kb <NUM>          Mean binary file size in KB (default: 64)
+    --depth <NUM>              Maximum directory depth (default: 4)
+    --secrets <NUM>            Planted secrets per pattern (default: 4)
+
+VERIFY:
+    Scans DIR with the built-in patterns (or reads a JSON report produced by
+    secret_detector --format json) and compares findings with
+    DIR/corpus_manifest.json. Fails if a planted secret is missed or a decoy
+    in an ignored or binary file is reported.
+)" << std::endl;
+    }
+
+    bool parseSize(const std::string& value, size_t& out) {
+        try {
+            out = static_cast<size_t>(std::stoull(value));
+            return true;
+        } catch (...) {
+            std::cerr << "Error: invalid number: " << value << std::endl;
+            return false;
+        }
+    }
+
+    bool parseMix(const std::string& value, CorpusOptions& options) {
+        unsigned weights[4];
+        if (std::sscanf(value.c_str(), "%u,%u,%u,%u",
+                        &weights[0], &weights[1], &weights[2], &weights[3]) != 4) {
+            std::cerr << "Error: --mix expects four comma-separated weights" << std::endl;
+            return false;
+        }
+        options.source_weight = weights[0];
+        options.minified_weight = weights[1];
+        options.log_weight = weights[2];
+        options.binary_weight = weights[3];
+        return true;
+    }
+
+    /**
+     * Находки из JSON отчета (схема ScanResult::to_json)
+     */
+    bool loadReportMatches(const std::string& path, std::vector<Match>& matches) {
+        try {
+            std::ifstream file(path);
+            if (!file.is_open()) {
+                std::cerr << "Error: cannot open report: " << path << std::endl;
+                return false;
+            }
+            json report;
+            file >> report;
+            for (const auto& item : report.at("results")) {
+                Match match;
+                match.file_path = item.at("file_path").get<std::string>();
+                match.line_number = item.at("line_number").get<int>();
+                match.pattern_name = item.at("pattern_name").get<std::string>();
+                matches.push_back(std::move(match));
+            }
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: invalid report " << path << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    int generate(const std::string& root, int argc, char* argv[], int first) {
+        CorpusOptions options;
+        for (int i = first; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Error: missing value for " << arg << std::endl;
+                return 2;
+            }
+            std::string value = argv[++i];
+            size_t number = 0;
+            bool ok = true;
+            if (arg == "--mix") {
+                ok = parseMix(value, options);
+            } else if ((ok = parseSize(value, number))) {
+                if (arg == "--seed") options.seed = static_cast<uint32_t>(number);
+                else if (arg == "--files") options.file_count = number;
+                else if (arg == "--source-kb") options.source_size_kb = number;
+                else if (arg == "--minified-kb") options.minified_size_kb = number;
+                else if (arg == "--log-kb") options.log_size_kb = number;
+                else if (arg == "--binary-kb") options.binary_size_kb = number;
+                else if (arg == "--depth") options.max_depth = number;
+                else if (arg == "--secrets") options.secrets_per_pattern = number;
+                else {
+                    std::cerr << "Error: unknown option " << arg << std::endl;
+                    return 2;
+                }
+            }
+            if (!ok) {
+                return 2;
+            }
+        }
+
+        PatternMatcher matcher;
+        if (!matcher.loadFromJson(ConfigManager::getDefaultPatterns())) {
+            return 1;
+        }
+
+        CorpusGenerator generator(options);
+        CorpusManifest manifest;
+        if (!generator.generate(root, matcher.getPatterns(), manifest)) {
+            return 1;
+        }
+
+        std::cout << "Corpus: " << root << "\n"
+                  << "  seed:    " << options.seed << "\n"
+                  << "  files:   " << manifest.file_count << "\n"
+                  << "  bytes:   " << manifest.total_bytes << "\n"
+                  << "  secrets: " << manifest.secrets.size() << std::endl;
+        return 0;
+    }
+
+    int verify(const std::string& root, int argc, char* argv[], int first) {
+        std::string report_path;
+        int threads = 0;
+        for (int i = first; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--report" && i + 1 < argc) {
+                report_path = argv[++i];
+            } else if (arg == "--threads" && i + 1 < argc) {
+                size_t number = 0;
+                if (!parseSize(argv[++i], number)) {
+                    return 2;
+                }
+                threads = static_cast<int>(number);
+            } else {
+                std::cerr << "Error: unknown option " << arg << std::endl;
+                return 2;
+            }
+        }
+
+        CorpusManifest manifest;
+        if (!CorpusGenerator::loadManifest(root + "/" + CorpusGenerator::MANIFEST_NAME, manifest)) {
+            return 1;
+        }
+
+        std::vector<Match> matches;
+        if (!report_path.empty()) {
+            if (!loadReportMatches(report_path, matches)) {
+                return 1;
+            }
+        } else {
+            SecretDetector detector;
+            if (!detector.initialize("")) {
+                return 1;
+            }
+            ScanOptions options;
+            options.scan_path = root;
+            options.num_threads = threads;
+            matches = detector.scan(options).matches;
+        }
+
+        CorpusVerification result = CorpusGenerator::verify(manifest, matches, root);
+        for (const auto& error : result.errors) {
+            std::cout << "  " << error << "\n";
+        }
+        std::cout << "Expected: " << result.expected << "\n"
+                  << "Found:    " << result.found << "\n"
+                  << "Missed:   " << result.missed << "\n"
+                  << "Leaked:   " << result.leaked << "\n"
+                  << "Extra:    " << result.extra << " (not in manifest)\n"
+                  << (result.passed() ? "VERIFY PASSED" : "VERIFY FAILED") << std::endl;
+        return result.passed() ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return argc < 2 ? 2 : (std::string(argv[1]) == "--help" ? 0 : 2);
+    }
+
+    Logger::initialize("", spdlog::level::err);
+
+    std::string command = argv[1];
+    std::string root = argv[2];
+    if (command == "generate") {
+        return generate(root, argc, argv, 3);
+    }
+    if (command == "verify") {
+        return verify(root, argc, argv, 3);
+    }
+
+    printUsage();
+    return 2;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+#
+# Запуск бенчмарков с повторами и сравнение с локальным baseline.
+#
+#   bench/run_benchmarks.sh save    [BUILD_DIR]   # записать baseline (обычно на main)
+#   bench/run_benchmarks.sh compare [BUILD_DIR]   # сравнить текущую сборку с baseline
+#
+# Переменные окружения:
+#   BENCH_BASELINE     файл baseline (по умолчанию BUILD_DIR/bench_baseline.json)
+#   BENCH_FILTER       регулярное выражение для --benchmark_filter (по умолчанию все)
+#   BENCH_REPETITIONS  повторов каждого бенчмарка (по умолчанию 5)
+#   BENCH_THRESHOLD    допустимое падение пропускной способности, % (по умолчанию 5)
+#   BENCH_SIGMAS       во сколько раз падение должно превышать шум (по умолчанию 3)
+#   BENCH_SKIP_VERIFY  1 - не проверять находки на синтетическом корпусе
+
+set -euo pipefail
+
+MODE="${1:-compare}"
+BUILD_DIR="${2:-build-bench}"
+BASELINE="${BENCH_BASELINE:-$BUILD_DIR/bench_baseline.json}"
+FILTER="${BENCH_FILTER:-.}"
+REPETITIONS="${BENCH_REPETITIONS:-5}"
+THRESHOLD="${BENCH_THRESHOLD:-5}"
+SIGMAS="${BENCH_SIGMAS:-3}"
+
+BENCH="$BUILD_DIR/bench/secret_detector_bench"
+COMPARE="$BUILD_DIR/bench/secret_detector_bench_compare"
+CORPUS="$BUILD_DIR/bench/secret_detector_corpus"
+
+for tool in "$BENCH" "$COMPARE" "$CORPUS"; do
+    if [[ ! -x "$tool" ]]; then
+        echo "error: $tool not found; configure with -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release" >&2
+        exit 2
+    fi
+done
+
+case "$MODE" in
+    save|compare) ;;
+    *)
+        echo "usage: $0 save|compare [BUILD_DIR]" >&2
+        exit 2
+        ;;
+esac
+
+if [[ "$MODE" == "compare" && ! -f "$BASELINE" ]]; then
+    echo "error: baseline $BASELINE not found; run '$0 save $BUILD_DIR' first" >&2
+    exit 2
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# ускорение не должно терять находки: эталонный корпус проверяется до замеров
+if [[ "${BENCH_SKIP_VERIFY:-0}" != "1" ]]; then
+    echo "== Verifying findings on the synthetic corpus"
+    "$CORPUS" generate "$WORK_DIR/corpus" --seed 1 --files 300 --log-kb 128 >/dev/null
+    "$CORPUS" verify "$WORK_DIR/corpus"
+fi
+
+echo "== Running benchmarks ($REPETITIONS repetitions, filter '$FILTER')"
+"$BENCH" \
+    --benchmark_filter="$FILTER" \
+    --benchmark_repetitions="$REPETITIONS" \
+    --benchmark_enable_random_interleaving=true \
+    --benchmark_report_aggregates_only=false \
+    --benchmark_out="$WORK_DIR/run.json" \
+    --benchmark_out_format=json \
+    --benchmark_display_aggregates_only=true
+
+if [[ "$MODE" == "save" ]]; then
+    "$COMPARE" save "$WORK_DIR/run.json" "$BASELINE"
+else
+    echo "== Comparing against $BASELINE"
+    "$COMPARE" compare "$BASELINE" "$WORK_DIR/run.json" --threshold "$THRESHOLD" --sigmas "$SIGMAS"
+fi
@@ -0,0 +1,154 @@
+#include "api/secret_detector_c.h"
+#include "core/secret_detector.h"
+#include "utils/logger.h"
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct sd_detector {
+    SecretDetector detector;
+};
+
+struct sd_cancel {
+    std::shared_ptr<CancellationToken> token = std::make_shared<CancellationToken>();
+};
+
+struct sd_result {
+    ScanResult scan;
+    std::vector<sd_match> matches;  // указывают на строки scan.matches
+};
+
+namespace {
+    thread_local std::string last_error;
+
+    void setError(const std::string& message) {
+        last_error = message;
+    }
+}
+
+extern "C" {
+
+const char* sd_version(void) {
+    return VERSION;
+}
+
+const char* sd_last_error(void) {
+    return last_error.c_str();
+}
+
+void sd_set_log_level(sd_log_level level) {
+    try {
+        Logger::setLevel(static_cast<spdlog::level::level_enum>(level));
+    } catch (const std::exception& e) {
+        setError(e.what());
+    }
+}
+
+sd_detector* sd_detector_new(const char* patterns_path) {
+    try {
+        auto handle = std::make_unique<sd_detector>();
+        if (!handle->detector.initialize(patterns_path ? patterns_path : "")) {
+            setError("failed to load patterns");
+            return nullptr;
+        }
+        last_error.clear();
+        return handle.release();
+    } catch (const std::exception& e) {
+        setError(e.what());
+        return nullptr;
+    }
+}
+
+void sd_detector_free(sd_detector* detector) {
+    delete detector;
+}
+
+size_t sd_detector_pattern_count(const sd_detector* detector) {
+    return detector ? detector->detector.getMatcher().getPatternCount() : 0;
+}
+
+sd_result* sd_scan_buffer(const sd_detector* detector, const char* data, size_t size, const char* name) {
+    return sd_scan_buffer_cancellable(detector, data, size, name, nullptr);
+}
+
+sd_cancel* sd_cancel_new(void) {
+    try {
+        return new sd_cancel();
+    } catch (const std::exception& e) {
+        setError(e.what());
+        return nullptr;
+    }
+}
+
+void sd_cancel_request(sd_cancel* cancel) {
+    if (cancel) {
+        cancel->token->cancel();
+    }
+}
+
+void sd_cancel_free(sd_cancel* cancel) {
+    delete cancel;
+}
+
+sd_result* sd_scan_buffer_cancellable(const sd_detector* detector, const char* data, size_t size,
+                                      const char* name, const sd_cancel* cancel) {
+    if (!detector || (!data && size > 0)) {
+        setError("invalid argument");
+        return nullptr;
+    }
+    try {
+        ScanOptions options;
+        if (cancel) {
+            options.cancel = cancel->token;
+        }
+        auto result = std::make_unique<sd_result>();
+        result->scan = detector->detector.scanBuffer(data, size, name ? name : "<buffer>", options);
+
+        result->matches.reserve(result->scan.matches.size());
+        for (const auto& match : result->scan.matches) {
+            sd_match entry;
+            entry.file_path = match.file_path.c_str();
+            entry.pattern_name = match.pattern_name.c_str();
+            entry.severity = match.severity.c_str();
+            entry.matched_text = match.matched_text.c_str();
+            entry.preview = match.preview.c_str();
+            entry.line_number = match.line_number;
+            entry.column_number = match.column_number;
+            result->matches.push_back(entry);
+        }
+        return result.release();
+    } catch (const std::exception& e) {
+        setError(e.what());
+        return nullptr;
+    }
+}
+
+size_t sd_result_count(const sd_result* result) {
+    return result ? result->matches.size() : 0;
+}
+
+const sd_match* sd_result_get(const sd_result* result, size_t index) {
+    if (!result || index >= result->matches.size()) {
+        return nullptr;
+    }
+    return &result->matches[index];
+}
+
+int sd_result_has_critical(const sd_result* result) {
+    return result && result->scan.has_critical ? 1 : 0;
+}
+
+int sd_result_partial(const sd_result* result) {
+    return result && !result->scan.statistics.partial_files.empty() ? 1 : 0;
+}
+
+int sd_result_cancelled(const sd_result* result) {
+    return result && result->scan.statistics.cancelled ? 1 : 0;
+}
+
+void sd_result_free(sd_result* result) {
+    delete result;
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+/*
+ * C API libsecretdetector
+ *
+ * Тонкая обертка над SecretDetector для сервисов на других языках (или на C),
+ * которым нужно сканировать данные в своем процессе. Исключения через
+ * границу API не проходят: функция возвращает NULL / 0, а текст ошибки
+ * доступен через sd_last_error() в том же потоке.
+ *
+ * Детектор после создания только читается - sd_scan_buffer можно вызывать
+ * для одного детектора из нескольких потоков.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* версия C API: меняется только при несовместимых изменениях */
+#define SD_API_VERSION 1
+
+typedef struct sd_detector sd_detector;
+typedef struct sd_result sd_result;
+typedef struct sd_cancel sd_cancel;
+
+/* уровни логирования (совпадают со spdlog) */
+typedef enum sd_log_level {
+    SD_LOG_TRACE = 0,
+    SD_LOG_DEBUG = 1,
+    SD_LOG_INFO = 2,
+    SD_LOG_WARN = 3,
+    SD_LOG_ERROR = 4,
+    SD_LOG_CRITICAL = 5,
+    SD_LOG_OFF = 6
+} sd_log_level;
+
+/* одна находка; строки принадлежат sd_result и живут до sd_result_free */
+typedef struct sd_match {
+    const char* file_path;      /* имя буфера, переданное в sd_scan_buffer */
+    const char* pattern_name;
+    const char* severity;       /* CRITICAL, HIGH, MEDIUM, LOW */
+    const char* matched_text;
+    const char* preview;        /* строка с находкой */
+    int line_number;            /* с 1 */
+    int column_number;          /* с 1, в байтах */
+} sd_match;
+
+/* версия библиотеки, например "1.0.0" */
+const char* sd_version(void);
+
+/* текст последней ошибки в текущем потоке ("" - ошибок не было) */
+const char* sd_last_error(void);
+
+/* уровень логирования библиотеки (по умолчанию INFO, в stderr) */
+void sd_set_log_level(sd_log_level level);
+
+/*
+ * Создать детектор
+ * patterns_path: путь до patterns.json или NULL - встроенные паттерны
+ * Возвращает NULL при ошибке.
+ */
+sd_detector* sd_detector_new(const char* patterns_path);
+
+void sd_detector_free(sd_detector* detector);
+
+/* количество загруженных паттернов */
+size_t sd_detector_pattern_count(const sd_detector* detector);
+
+/*
+ * Просканировать буфер в памяти
+ * name: имя буфера в находках (NULL - "<buffer>")
+ * Возвращает NULL при ошибке; результат освобождается sd_result_free.
+ */
+sd_result* sd_scan_buffer(const sd_detector* detector, const char* data, size_t size, const char* name);
+
+/*
+ * Флаг отмены для sd_scan_buffer_cancellable
+ * sd_cancel_request можно вызывать из другого потока и из обработчика сигнала:
+ * идущее сканирование останавливается между паттернами и возвращает то,
+ * что успело найти (sd_result_cancelled == 1).
+ */
+sd_cancel* sd_cancel_new(void);
+void sd_cancel_request(sd_cancel* cancel);
+void sd_cancel_free(sd_cancel* cancel);
+
+/* sd_scan_buffer с отменой (cancel может быть NULL) */
+sd_result* sd_scan_buffer_cancellable(const sd_detector* detector, const char* data, size_t size,
+                                      const char* name, const sd_cancel* cancel);
+
+size_t sd_result_count(const sd_result* result);
+
+/* находка по индексу (NULL, если индекс вне диапазона) */
+const sd_match* sd_result_get(const sd_result* result, size_t index);
+
+/* 1, если есть находки CRITICAL */
+int sd_result_has_critical(const sd_result* result);
+
+/* 1, если буфер просканирован частично (превышен бюджет, см. --file-budget) */
+int sd_result_partial(const sd_result* result);
+
+/* 1, если сканирование было отменено (находки неполные) */
+int sd_result_cancelled(const sd_result* result);
+
+void sd_result_free(sd_result* result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,6 +2,7 @@
 #include "utils/logger.h"
 #include <iostream>
 #include <algorithm>
+#include <cctype>
 
 CLIOptions CLIParser::parse(int argc, char* argv[]) {
     CLIOptions options;
@@ -18,6 +19,15 @@ CLIOptions CLIParser::parse(int argc, char* argv[]) {
         else if (arg == "--path" && i + 1 < argc) {
             options.scan_path = argv[++i];
         }
+        else if (arg == "--stdin" || arg == "-") {
+            options.read_stdin = true;
+        }
+        else if (arg == "--git-history") {
+            options.git_history = true;
+        }
+        else if (arg == "--stdin-name" && i + 1 < argc) {
+            options.stdin_name = argv[++i];
+        }
         else if (arg == "--output" || arg == "-o") {
             if (i + 1 < argc) {
                 options.output_path = argv[++i];
@@ -29,6 +39,26 @@ CLIOptions CLIParser::parse(int argc, char* argv[]) {
         else if (arg == "--format" && i + 1 < argc) {
             options.format = argv[++i];
         }
+        else if (arg == "--baseline" && i + 1 < argc) {
+            options.baseline_path = argv[++i];
+        }
+        else if (arg == "--update-baseline" && i + 1 < argc) {
+            options.update_baseline_path = argv[++i];
+        }
+        else if (arg == "--read-report" && i + 1 < argc) {
+            options.read_report = argv[++i];
+        }
+        else if (arg == "--filter-severity" && i + 1 < argc) {
+            options.filter_severity = argv[++i];
+            std::transform(options.filter_severity.begin(), options.filter_severity.end(),
+                           options.filter_severity.begin(), ::toupper);
+        }
+        else if (arg == "--filter-pattern" && i + 1 < argc) {
+            options.filter_pattern = argv[++i];
+        }
+        else if (arg == "--filter-path" && i + 1 < argc) {
+            options.filter_path = argv[++i];
+        }
         else if (arg == "--verbose") {
             options.verbose = true;
         }
@@ -41,6 +71,50 @@ CLIOptions CLIParser::parse(int argc, char* argv[]) {
         else if (arg == "--no-gitignore") {
             options.respect_gitignore = false;
         }
+        else if (arg == "--no-dedup") {
+            options.deduplicate = false;
+        }
+        else if (arg == "--metrics-file" && i + 1 < argc) {
+            options.metrics_path = argv[++i];
+        }
+        else if (arg == "--watch") {
+            options.watch = true;
+        }
+        else if (arg == "--compile-patterns") {
+            options.compile_patterns = true;
+        }
+        else if (arg == "--serve" && i + 1 < argc) {
+            options.serve_socket = argv[++i];
+        }
+        else if (arg == "--client" && i + 1 < argc) {
+            options.client_socket = argv[++i];
+        }
+        else if (arg == "--trace" && i + 1 < argc) {
+            options.trace_path = argv[++i];
+        }
+        else if (arg == "--profile-patterns") {
+            options.profile_patterns = true;
+        }
+        else if (arg == "--engine" && i + 1 < argc) {
+            options.engine = argv[++i];
+        }
+        else if (arg == "--verify-engines") {
+            options.verify_engines = true;
+        }
+        else if (arg == "--file-budget" && i + 1 < argc) {
+            try {
+                options.file_budget_ms = std::stod(argv[++i]);
+            } catch (...) {
+                LOG_WARN("Invalid file budget");
+            }
+        }
+        else if (arg == "--max-line-length" && i + 1 < argc) {
+            try {
+                options.max_line_length = std::stoll(argv[++i]);
+            } catch (...) {
+                LOG_WARN("Invalid max line length");
+            }
+        }
         else if (arg == "--threads" && i + 1 < argc) {
             try {
                 options.num_threads = std::stoi(argv[++i]);
@@ -75,14 +149,57 @@ USAGE:
 
 OPTIONS:
     --path <PATH>               Path to scan (can also be positional argument)
+    --stdin, -                 Scan data piped to stdin instead of files
+    --stdin-name <NAME>        Name used for stdin in reports (default: <stdin>)
+    --git-history              Scan every commit of the git repository at PATH
+                               (each unique blob is scanned once)
     --output, -o <PATH>        Output file path
     --config <PATH>            Path to patterns.json config
-    --format <FORMAT>          Output format: text, json, csv, html (default: text)
+    --format <FORMAT>          Output format: text, json, ndjson, sarif, binary, csv, html
+                               (default: text)
+                               (ndjson prints each finding as soon as it is found)
+    --baseline <FILE>          Suppress findings already recorded in a baseline file
+    --update-baseline <FILE>   Write (or refresh) a baseline from this scan's findings
+    --read-report <FILE>       Load a binary report instead of scanning and print or
+                               convert it with --format / --output
+    --filter-severity <LEVEL>  Only findings with this severity (with --read-report)
+    --filter-pattern <NAME>    Only findings of this pattern (with --read-report)
+    --filter-path <PREFIX>     Only findings under this path prefix (with --read-report)
     --verbose                  Enable verbose logging
     --strict                   Fail on ANY match (not just CRITICAL/HIGH)
     --no-recursive             Don't scan subdirectories
     --no-gitignore             Don't respect .gitignore
+    --no-dedup                 Scan identical files and hardlinks separately
     --threads <NUM>            Number of threads (0 = auto)
+    --metrics-file <FILE>      Write scan metrics in Prometheus text format
+                               (for the node_exporter textfile collector)
+    --profile-patterns         Print time, bytes and hits per pattern (slowest first)
+                               and add them to the JSON report
+    --trace <FILE>             Record a timeline of the scan per thread (walk, open,
+                               read, binary check, match per pattern, export) as
+                               Chrome trace-event JSON for chrome://tracing or Perfetto
+    --engine <ENGINE>          Matching engine: regex, prefilter (default: regex)
+                               (prefilter skips a pattern when none of its required
+                               literals occurs in the file)
+    --verify-engines           Scan PATH with every engine and report any finding
+                               that differs from the regex engine (also runs
+                               generated inputs); exit code 1 on a difference
+    --file-budget <MS>         Matching time per file; a slower file is finished in
+                               windows around pattern literals and reported as
+                               partially scanned (default: 10000, 0 = unlimited)
+    --max-line-length <BYTES>  Scan lines longer than this in windows, e.g. minified
+                               files (default: 16384, 0 = unlimited)
+    --watch                    Scan PATH, then keep watching it (inotify) and rescan
+                               only created or changed files; prints new and resolved
+                               findings after each burst of changes (text or ndjson)
+    --compile-patterns         Compile the patterns config into a binary bundle
+                               (default: <config>.bundle, or --output) that later
+                               runs load without parsing or checking the JSON
+    --serve <SOCKET>           Run as a server on a Unix socket: patterns are compiled
+                               once and scan requests (paths or buffers) are answered
+                               with NDJSON findings; stop with Ctrl+C or SIGTERM
+    --client <SOCKET>          Send this scan (PATH or --stdin) to a running server
+                               and print its findings (--format text or ndjson)
     --exclude <PATTERN>        Exclude pattern (can be used multiple times)
     --include-ext <EXT>        Include only these extensions (can be used multiple times)
     --help, -h                 Show this help message
@@ -101,6 +218,49 @@ EXAMPLES:
     # Exclude node_modules and .git
     secret_detector --exclude node_modules --exclude .git /repo
 
+    # SARIF report for code scanning dashboards
+    secret_detector --format sarif --output results.sarif /repo
+
+    # Accept current findings, then report only new ones
+    secret_detector --update-baseline .secrets-baseline /repo
+    secret_detector --baseline .secrets-baseline /repo
+
+    # Compact binary report for storage, converted to HTML later
+    secret_detector --format binary --output nightly.sdr /repo
+    secret_detector --read-report nightly.sdr --filter-severity critical --format html -o critical.html
+
+    # Live findings for CI (one JSON object per line)
+    secret_detector --format ndjson /repo
+
+    # Scan the full history of a repository
+    secret_detector --git-history /repo
+
+    # Nightly scan graphed through node_exporter
+    secret_detector --metrics-file /var/lib/node_exporter/secret_detector.prom /srv
+
+    # Find out which patterns make a scan slow
+    secret_detector --profile-patterns /repo
+
+    # See where a slow scan spends its time, thread by thread
+    secret_detector --trace scan.trace.json /repo
+
+    # Check that the prefilter engine finds exactly what regex finds
+    secret_detector --verify-engines /repo
+
+    # Keep a workspace under watch while you edit
+    secret_detector --watch ~/src/project
+
+    # Precompile a large rule pack (rerun after editing patterns.json)
+    secret_detector --compile-patterns --config /etc/secret_detector/patterns.json
+
+    # Keep patterns warm for hooks and editors
+    secret_detector --serve /run/user/1000/secret_detector.sock &
+    secret_detector --client /run/user/1000/secret_detector.sock src/
+    secret_detector --client /run/user/1000/secret_detector.sock --stdin --stdin-name app.env < app.env
+
+    # Scan a pipeline without temp files
+    git diff | secret_detector --stdin --stdin-name git-diff
+
 PATTERNS SUPPORTED:
     - AWS Keys (AKIA...)
     - GitHub Tokens
@@ -118,14 +278,113 @@ void CLIParser::printVersion() {
 }
 
 bool CLIParser::validate(const CLIOptions& options) {
-    if (options.scan_path.empty()) {
+    if (options.compile_patterns) {
+        if (!options.scan_path.empty() || options.read_stdin || !options.read_report.empty() ||
+            !options.serve_socket.empty() || !options.client_socket.empty()) {
+            std::cerr << "Error: --compile-patterns only compiles the config and cannot be combined "
+                         "with a scan" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    if (!options.read_report.empty()) {
+        if (!options.scan_path.empty() || options.read_stdin || options.git_history ||
+            !options.update_baseline_path.empty()) {
+            std::cerr << "Error: --read-report cannot be combined with a scan" << std::endl;
+            return false;
+        }
+        if (options.profile_patterns || !options.metrics_path.empty() || options.verify_engines) {
+            std::cerr << "Error: --profile-patterns, --metrics-file and --verify-engines require a scan"
+                      << std::endl;
+            return false;
+        }
+    } else if (!options.filter_severity.empty() || !options.filter_pattern.empty() ||
+               !options.filter_path.empty()) {
+        std::cerr << "Error: --filter-* options require --read-report" << std::endl;
+        return false;
+    }
+
+    if (!options.serve_socket.empty()) {
+        if (!options.scan_path.empty() || options.read_stdin || options.git_history ||
+            !options.read_report.empty() || options.verify_engines || !options.client_socket.empty() ||
+            !options.update_baseline_path.empty() || options.watch) {
+            std::cerr << "Error: --serve takes requests from clients and cannot be combined with a scan"
+                      << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    if (options.watch) {
+        if (options.read_stdin || options.git_history || !options.read_report.empty() ||
+            options.verify_engines || !options.update_baseline_path.empty() ||
+            !options.output_path.empty() || !options.client_socket.empty()) {
+            std::cerr << "Error: --watch scans a directory and prints changes to stdout" << std::endl;
+            return false;
+        }
+        if (options.format != "text" && options.format != "ndjson") {
+            std::cerr << "Error: --watch supports --format text or ndjson" << std::endl;
+            return false;
+        }
+    }
+
+    if (!options.client_socket.empty()) {
+        if (options.git_history || !options.read_report.empty() || options.verify_engines ||
+            !options.update_baseline_path.empty() || !options.output_path.empty()) {
+            std::cerr << "Error: --client supports a path or --stdin scan printed to stdout" << std::endl;
+            return false;
+        }
+        if (options.format != "text" && options.format != "ndjson") {
+            std::cerr << "Error: --client supports --format text or ndjson" << std::endl;
+            return false;
+        }
+    }
+
+    if (options.scan_path.empty() && !options.read_stdin && options.read_report.empty()) {
         std::cerr << "Error: scan path is required" << std::endl;
         return false;
     }
+
+    if (!options.scan_path.empty() && options.read_stdin) {
+        std::cerr << "Error: --stdin cannot be combined with a scan path" << std::endl;
+        return false;
+    }
+
+    if (!options.update_baseline_path.empty() && options.read_stdin) {
+        std::cerr << "Error: --update-baseline cannot be combined with --stdin" << std::endl;
+        return false;
+    }
+
+    if (options.git_history && options.read_stdin) {
+        std::cerr << "Error: --git-history cannot be combined with --stdin" << std::endl;
+        return false;
+    }
     
-    if (options.format != "text" && options.format != "json" && 
+    if (options.verify_engines && (options.read_stdin || options.git_history)) {
+        std::cerr << "Error: --verify-engines requires a directory scan" << std::endl;
+        return false;
+    }
+
+    if (options.file_budget_ms < 0 || options.max_line_length < 0) {
+        std::cerr << "Error: --file-budget and --max-line-length must not be negative" << std::endl;
+        return false;
+    }
+
+    if (options.engine != "regex" && options.engine != "prefilter") {
+        std::cerr << "Error: invalid engine. Must be one of: regex, prefilter" << std::endl;
+        return false;
+    }
+
+    if (options.format != "text" && options.format != "json" && options.format != "ndjson" &&
+        options.format != "sarif" && options.format != "binary" &&
         options.format != "csv" && options.format != "html") {
-        std::cerr << "Error: invalid format. Must be one of: text, json, csv, html" << std::endl;
+        std::cerr << "Error: invalid format. Must be one of: text, json, ndjson, sarif, binary, csv, html" << std::endl;
+        return false;
+    }
+
+    if (options.format == "binary" && options.output_path.empty()) {
+        std::cerr << "Error: --format binary requires --output" << std::endl;
         return false;
     }
     
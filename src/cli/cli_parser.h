@@ -9,15 +9,36 @@
  */
 struct CLIOptions {
     std::string scan_path;              ///< Путь для сканирования
+    bool read_stdin = false;            ///< Сканировать stdin вместо файлов
+    bool git_history = false;           ///< Сканировать всю историю git-репозитория
+    std::string stdin_name = "<stdin>"; ///< Имя потока stdin в отчете
     std::string output_path;            ///< Путь для вывода результатов
     std::string config_path;            ///< Путь до конфига паттернов
-    std::string format = "text";        ///< Формат вывода (text, json, csv, html)
+    std::string format = "text";        ///< Формат вывода (text, json, ndjson, sarif, binary, csv, html)
+    std::string baseline_path;          ///< Baseline известных находок (подавляются)
+    std::string update_baseline_path;   ///< Записать baseline по результатам сканирования
+    std::string read_report;            ///< Бинарный отчет для конвертации вместо сканирования
+    std::string filter_severity;        ///< Выборка из бинарного отчета по severity
+    std::string filter_pattern;         ///< Выборка из бинарного отчета по паттерну
+    std::string filter_path;            ///< Выборка из бинарного отчета по префиксу пути
     bool verbose = false;               ///< Подробное логирование
     bool strict = false;                ///< Строгий режим (блокировать при любых секретах)
     bool recursive = true;              ///< Сканировать рекурсивно
     bool help = false;                  ///< Показать справку
     bool version = false;               ///< Показать версию
     bool respect_gitignore = true;      ///< Использовать .gitignore
+    bool deduplicate = true;            ///< Сканировать одинаковые файлы один раз
+    bool profile_patterns = false;      ///< Профилировать время и срабатывания паттернов
+    std::string metrics_path;           ///< Файл метрик Prometheus (textfile collector)
+    std::string trace_path;             ///< Временная шкала в формате Chrome trace-event
+    std::string serve_socket;           ///< Запустить сервер на этом Unix socket
+    std::string client_socket;          ///< Отправить сканирование серверу на этом socket
+    bool watch = false;                 ///< Наблюдать за деревом и сообщать об изменениях находок
+    bool compile_patterns = false;      ///< Скомпилировать конфиг в бандл вместо сканирования
+    std::string engine = "regex";       ///< Движок поиска (regex, prefilter)
+    bool verify_engines = false;        ///< Сравнить находки движков вместо отчета
+    double file_budget_ms = 10000.0;    ///< Время поиска на файл (0 - без ограничения)
+    long long max_line_length = 16384;  ///< Строки длиннее сканируются окнами (0 - без ограничения)
     std::vector<std::string> exclude_patterns;  ///< Паттерны для исключения
     std::vector<std::string> include_extensions;  ///< Расширения для включения
     int num_threads = 0;                ///< Количество потоков (0 = авто)
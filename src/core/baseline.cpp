@@ -0,0 +1,152 @@
+#include "core/baseline.h"
+#include "utils/hash_utils.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+namespace fs = std::filesystem;
+
+bool Baseline::load(const std::string& path) {
+    try {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR_FMT("Cannot open baseline: {}", path);
+            return false;
+        }
+
+        fingerprints.clear();
+
+        std::string line;
+        size_t line_number = 0;
+        while (std::getline(file, line)) {
+            line_number++;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::string hex = line.substr(0, line.find_first_of(" \t\r"));
+            char* end = nullptr;
+            uint64_t value = std::strtoull(hex.c_str(), &end, 16);
+            if (hex.size() != 16 || end != hex.c_str() + hex.size()) {
+                LOG_WARN_FMT("Invalid baseline entry at {}:{}", path, line_number);
+                continue;
+            }
+            fingerprints.insert(value);
+        }
+
+        LOG_INFO_FMT("Loaded baseline with {} known findings", fingerprints.size());
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error loading baseline: {}", e.what());
+        return false;
+    }
+}
+
+bool Baseline::save(const std::vector<Match>& matches, const std::string& root,
+                    const std::string& path) {
+    try {
+        // сортировка по пути делает diff baseline'а между запусками читаемым
+        std::vector<std::tuple<std::string, std::string, uint64_t>> entries;
+        entries.reserve(matches.size());
+        for (const auto& match : matches) {
+            entries.emplace_back(normalizePath(match.file_path, root), match.pattern_name,
+                                 fingerprint(match, root));
+        }
+        std::sort(entries.begin(), entries.end());
+        entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+        // запись во временный файл и переименование - baseline не бывает обрезанным
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream file(tmp_path);
+            if (!file.is_open()) {
+                LOG_ERROR_FMT("Cannot open file for writing: {}", tmp_path);
+                return false;
+            }
+
+            file << "# secret_detector baseline v1\n";
+            file << "# <fingerprint> <pattern> <path>\n";
+            for (const auto& [file_path, pattern, hash] : entries) {
+                file << HashUtils::toHex(hash) << " " << pattern << " " << file_path << "\n";
+            }
+
+            if (!file) {
+                LOG_ERROR_FMT("Error writing baseline: {}", tmp_path);
+                return false;
+            }
+        }
+        fs::rename(tmp_path, path);
+
+        LOG_INFO_FMT("Baseline written: {} ({} findings)", path, entries.size());
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error writing baseline: {}", e.what());
+        return false;
+    }
+}
+
+uint64_t Baseline::fingerprint(const Match& match, const std::string& root) {
+    std::string key;
+    key.reserve(match.pattern_name.size() + match.file_path.size() + match.matched_text.size() + 2);
+    key += match.pattern_name;
+    key += '\0';
+    key += normalizePath(match.file_path, root);
+    key += '\0';
+    key += normalizeText(match.matched_text);
+    return HashUtils::hash64(key);
+}
+
+size_t Baseline::filter(std::vector<Match>& matches, const std::string& root) const {
+    if (fingerprints.empty() || matches.empty()) {
+        return 0;
+    }
+
+    size_t before = matches.size();
+    matches.erase(std::remove_if(matches.begin(), matches.end(),
+                                 [&](const Match& match) {
+                                     return contains(fingerprint(match, root));
+                                 }),
+                  matches.end());
+    return before - matches.size();
+}
+
+std::string Baseline::normalizePath(const std::string& path, const std::string& root) {
+    std::string result = path;
+
+    if (!root.empty()) {
+        std::string prefix = root;
+        while (prefix.size() > 1 && prefix.back() == '/') {
+            prefix.pop_back();
+        }
+
+        if (result == prefix) {
+            // сканировался один файл - остается только имя
+            result = fs::path(result).filename().string();
+        } else if (result.compare(0, prefix.size(), prefix) == 0 &&
+                   (prefix.back() == '/' || result[prefix.size()] == '/')) {
+            result.erase(0, prefix.size());
+        }
+    }
+
+    while (!result.empty() && result[0] == '/' && !root.empty()) {
+        result.erase(0, 1);
+    }
+    while (result.rfind("./", 0) == 0) {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+std::string Baseline::normalizeText(const std::string& text) {
+    const char* trim_chars = " \t\r\n\"'`";
+    size_t begin = text.find_first_not_of(trim_chars);
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(trim_chars);
+    return text.substr(begin, end - begin + 1);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include "pattern_matcher.h"
+
+/**
+ * @class Baseline
+ * @brief Набор известных (принятых) находок для подавления в отчетах
+ *
+ * Отпечаток находки - XXH64 от имени паттерна, пути относительно корня
+ * сканирования и нормализованного текста совпадения. Номер строки в отпечаток
+ * не входит, поэтому сдвиг кода не делает находку новой.
+ *
+ * Формат файла - текст, по одной находке на строку:
+ *   <16 hex отпечатка> <паттерн> <путь>
+ * Строки, начинающиеся с '#', игнорируются.
+ */
+class Baseline {
+public:
+    Baseline() = default;
+    ~Baseline() = default;
+
+    /**
+     * Загрузить baseline из файла
+     * @param path Путь до файла baseline
+     * @return true если успешно
+     */
+    bool load(const std::string& path);
+
+    /**
+     * Записать baseline для находок
+     * @param matches Находки, которые станут известными
+     * @param root Корень сканирования (пути сохраняются относительно него)
+     * @param path Путь до файла baseline
+     * @return true если успешно
+     */
+    static bool save(const std::vector<Match>& matches, const std::string& root,
+                     const std::string& path);
+
+    /**
+     * Рассчитать отпечаток находки
+     * @param match Находка
+     * @param root Корень сканирования
+     */
+    static uint64_t fingerprint(const Match& match, const std::string& root);
+
+    /**
+     * Известна ли находка
+     */
+    bool contains(uint64_t fingerprint) const {
+        return fingerprints.count(fingerprint) > 0;
+    }
+
+    /**
+     * Удалить известные находки из вектора
+     * @return Количество удаленных находок
+     */
+    size_t filter(std::vector<Match>& matches, const std::string& root) const;
+
+    /**
+     * Количество отпечатков
+     */
+    size_t size() const { return fingerprints.size(); }
+
+    /**
+     * Путь относительно корня сканирования (без "./")
+     */
+    static std::string normalizePath(const std::string& path, const std::string& root);
+
+    /**
+     * Текст совпадения без пробелов и кавычек по краям
+     */
+    static std::string normalizeText(const std::string& text);
+
+private:
+    // ключи уже являются хэшами - повторно их не хэшировать
+    struct IdentityHash {
+        size_t operator()(uint64_t value) const { return static_cast<size_t>(value); }
+    };
+
+    std::unordered_set<uint64_t, IdentityHash> fingerprints;
+};
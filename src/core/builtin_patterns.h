@@ -0,0 +1,116 @@
+#pragma once
+
+#include <string_view>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum Severity
+ * @brief Уровень серьёзности встроенного паттерна
+ */
+enum class Severity : uint8_t {
+    Low,
+    Medium,
+    High,
+    Critical
+};
+
+/**
+ * Имя уровня в отчетах (CRITICAL, HIGH, MEDIUM, LOW)
+ */
+constexpr std::string_view severityName(Severity severity) {
+    switch (severity) {
+        case Severity::Critical: return "CRITICAL";
+        case Severity::High:     return "HIGH";
+        case Severity::Medium:   return "MEDIUM";
+        case Severity::Low:      return "LOW";
+    }
+    return "MEDIUM";
+}
+
+/**
+ * @struct BuiltinPattern
+ * @brief Встроенный паттерн (запись таблицы времени компиляции)
+ */
+struct BuiltinPattern {
+    std::string_view name;
+    std::string_view regex;             ///< Без (?i): встроенные всегда компилируются с icase (пусто - без regex)
+    Severity severity;
+    std::string_view description;
+    const std::string_view* anchors;    ///< Литералы префильтра (как у RegexPrefilter::extractAnchors)
+    size_t anchor_count;
+    bool use_entropy;
+    double entropy_threshold;
+};
+
+/**
+ * Встроенные паттерны - используются, когда конфиг не найден
+ *
+ * Таблица constexpr: загрузка не строит и не разбирает JSON, не выводит
+ * якоря и не прогоняет пробы стоимости regex (это проверяют тесты).
+ * Остается только компиляция std::regex. Записи отсортированы по имени -
+ * в том же порядке паттерны приходят из JSON-конфига.
+ */
+namespace BuiltinPatterns {
+    inline constexpr std::string_view API_KEY_ANCHORS[] = {
+        "api-key", "api-secret", "api_key", "apikey", "secret-key"};
+    inline constexpr std::string_view AWS_KEY_ANCHORS[] = {
+        "akia",
+        "aws-access-key", "aws-access_key", "aws-accesskey",
+        "aws-secret-access", "aws-secret_access", "aws-secretaccess",
+        "aws_access-key", "aws_access_key", "aws_accesskey",
+        "aws_secret-access", "aws_secret_access", "aws_secretaccess",
+        "awsaccess-key", "awsaccess_key", "awsaccesskey",
+        "awssecret-access", "awssecret_access", "awssecretaccess"};
+    inline constexpr std::string_view DATABASE_URL_ANCHORS[] = {
+        "mongodb://", "mysql://", "postgres://", "redis://"};
+    inline constexpr std::string_view GITHUB_TOKEN_ANCHORS[] = {
+        "ghp_",
+        "github-key", "github-pat", "github-token",
+        "github_key", "github_pat", "github_token",
+        "githubkey", "githubpat", "githubtoken"};
+    inline constexpr std::string_view PASSWORD_PLAIN_ANCHORS[] = {"passwd", "password", "pwd"};
+    inline constexpr std::string_view PRIVATE_KEY_ANCHORS[] = {"private key"};
+
+    inline constexpr BuiltinPattern TABLE[] = {
+        {"api_key",
+         R"((api[_-]?key|apikey|api-secret|secret-key)\s*[:=]\s*['\"]?[\w\-\._]+['\"]?)",
+         Severity::High, "Generic API Key",
+         API_KEY_ANCHORS, std::size(API_KEY_ANCHORS), false, 4.0},
+        {"aws_key",
+         R"((AKIA[0-9A-Z]{16}|aws[_-]?access[_-]?key[_-]?id|aws[_-]?secret[_-]?access[_-]?key))",
+         Severity::Critical, "AWS Access Key or Secret",
+         AWS_KEY_ANCHORS, std::size(AWS_KEY_ANCHORS), false, 4.0},
+        {"database_url",
+         R"((mongodb|mysql|postgres|redis)://[^\s]+)",
+         Severity::High, "Database connection string",
+         DATABASE_URL_ANCHORS, std::size(DATABASE_URL_ANCHORS), false, 4.0},
+        {"github_token",
+         R"((github[_\-]?(token|pat|key)|ghp_[a-zA-Z0-9_]{36,255}))",
+         Severity::Critical, "GitHub Personal Access Token",
+         GITHUB_TOKEN_ANCHORS, std::size(GITHUB_TOKEN_ANCHORS), false, 4.0},
+        // high_entropy - без regex, только энтропия
+        {"high_entropy", "", Severity::Medium, "High entropy string (possible secret)",
+         nullptr, 0, true, 4.5},
+        {"password_plain",
+         R"((password|passwd|pwd)\s*[:=]\s*['\"]?[^\s'"]+['\"]?)",
+         Severity::High, "Password in plain text",
+         PASSWORD_PLAIN_ANCHORS, std::size(PASSWORD_PLAIN_ANCHORS), false, 4.0},
+        {"private_key",
+         R"(-----BEGIN.*PRIVATE KEY.*-----)",
+         Severity::Critical, "Private Key (RSA, DSA, EC)",
+         PRIVATE_KEY_ANCHORS, std::size(PRIVATE_KEY_ANCHORS), false, 4.0},
+    };
+
+    constexpr bool sortedByName() {
+        for (size_t i = 1; i < std::size(TABLE); ++i) {
+            if (!(TABLE[i - 1].name < TABLE[i].name)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(sortedByName(), "built-in patterns must stay sorted by name (JSON config order)");
+}
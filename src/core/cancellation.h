@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @class CancellationToken
+ * @brief Флаг кооперативной отмены сканирования
+ *
+ * Обход, чтение и поиск проверяют флаг в дешевых точках (между файлами,
+ * блоками, паттернами и окнами) и завершаются с тем, что уже найдено.
+ * Поток не прерывается насильно - блокировки и ресурсы освобождаются
+ * обычным путем. cancel() - одна lock-free запись, ее можно вызывать
+ * из обработчика сигнала и из другого потока.
+ */
+class CancellationToken {
+public:
+    /**
+     * Запросить отмену
+     */
+    void cancel() noexcept { cancelled.store(true, std::memory_order_relaxed); }
+
+    /**
+     * Была ли запрошена отмена
+     */
+    bool isCancelled() const noexcept { return cancelled.load(std::memory_order_relaxed); }
+
+    /**
+     * Сбросить флаг перед повторным использованием
+     */
+    void reset() noexcept { cancelled.store(false, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+    static_assert(std::atomic<bool>::is_always_lock_free, "cancel() must be async-signal-safe");
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "pattern_matcher.h"
+
+using json = nlohmann::json;
+
+/**
+ * @struct EngineDifference
+ * @brief Находка, которую выдал только один из движков
+ */
+struct EngineDifference {
+    std::string file_path;      ///< Файл или имя входных данных
+    int line_number = 0;        ///< Номер строки (1-indexed)
+    int column_number = 0;      ///< Номер колонки (смещение в строке)
+    std::string pattern_name;   ///< Имя паттерна
+    std::string matched_text;   ///< Найденный текст
+    std::string only_in;        ///< Движок, который выдал находку
+
+    json to_json() const {
+        json j;
+        j["file"] = file_path;
+        j["line"] = line_number;
+        j["column"] = column_number;
+        j["pattern"] = pattern_name;
+        j["matched"] = matched_text;
+        j["only_in"] = only_in;
+        return j;
+    }
+};
+
+/**
+ * @struct EngineVerification
+ * @brief Результат сравнения движков
+ */
+struct EngineVerification {
+    size_t inputs = 0;              ///< Проверено файлов или сгенерированных входов
+    uint64_t bytes = 0;             ///< Проверено байт
+    size_t reference_matches = 0;   ///< Находок эталонного движка
+    size_t candidate_matches = 0;   ///< Находок проверяемого движка
+    std::vector<EngineDifference> differences;
+
+    bool passed() const { return differences.empty(); }
+
+    json to_json() const {
+        json j;
+        j["inputs"] = inputs;
+        j["bytes"] = bytes;
+        j["reference_matches"] = reference_matches;
+        j["candidate_matches"] = candidate_matches;
+        j["differences"] = json::array();
+        for (const auto& difference : differences) {
+            j["differences"].push_back(difference.to_json());
+        }
+        j["passed"] = passed();
+        return j;
+    }
+};
+
+/**
+ * @class EngineVerifier
+ * @brief Дифференциальная проверка движков поиска
+ *
+ * Проверяемый движок должен выдавать ровно те же находки
+ * (файл, строка, колонка, паттерн, текст), что и эталонный std::regex
+ * (MatchEngine::Regex). Сравнение идет как мультимножеств, порядок находок
+ * не важен.
+ */
+class EngineVerifier {
+public:
+    /**
+     * @param matcher Загруженные паттерны
+     * @param candidate Проверяемый движок
+     */
+    explicit EngineVerifier(const PatternMatcher& matcher,
+                            MatchEngine candidate = MatchEngine::Prefilter);
+
+    /**
+     * Сравнить находки двух движков и дописать различия в result
+     */
+    void compareMatches(const std::vector<Match>& reference,
+                        const std::vector<Match>& candidate,
+                        EngineVerification& result) const;
+
+    /**
+     * Прогнать оба движка на одном содержимом
+     */
+    void verifyContent(const std::string& content, const std::string& name,
+                       EngineVerification& result) const;
+
+    /**
+     * Прогнать оба движка на сгенерированных входах
+     * Входы собираются из якорей паттернов (в т.ч. обрезанных и в другом
+     * регистре), похожих на секреты строк, шума и случайных байт.
+     * @param seed Seed генератора (одинаковый seed - одинаковые входы)
+     * @param iterations Количество входов
+     */
+    EngineVerification verifyFuzz(uint32_t seed, size_t iterations) const;
+
+    /**
+     * Имя движка для отчетов
+     */
+    static std::string engineName(MatchEngine engine);
+
+private:
+    const PatternMatcher& matcher;
+    MatchEngine candidate_engine;
+};
@@ -1,16 +1,46 @@
 #include "core/file_scanner.h"
 #include "utils/logger.h"
 #include "utils/file_utils.h"
+#include "utils/hash_utils.h"
+#include "utils/trace_recorder.h"
 #include <filesystem>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <queue>
 #include <chrono>
 #include <fstream>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <cerrno>
+#include <cstring>
 
 namespace fs = std::filesystem;
 
+namespace {
+    // размер блока чтения из потока
+    constexpr size_t STREAM_READ_SIZE = 64 * 1024;
+    // максимальный размер несканированного хвоста (очень длинные строки режутся)
+    constexpr size_t STREAM_MAX_PENDING = 1024 * 1024;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+void ScanStatistics::recordPeakRss() {
+    struct rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+        // в Linux ru_maxrss в килобайтах
+        peak_rss_bytes = std::max<uint64_t>(peak_rss_bytes,
+                                            static_cast<uint64_t>(usage.ru_maxrss) * 1024);
+    }
+}
+
 FileScanner::FileScanner(ScanOptions opts) : options(std::move(opts)) {
+    // поиск внутри файла проверяет отмену вместе с бюджетом
+    options.file_budget.cancel = options.cancel.get();
     if (options.num_threads <= 0) {
         options.num_threads = std::thread::hardware_concurrency();
         if (options.num_threads == 0) options.num_threads = 4;
@@ -21,95 +51,391 @@ FileScanner::FileScanner(ScanOptions opts) : options(std::move(opts)) {
 std::vector<Match> FileScanner::scan(const PatternMatcher& matcher) {
     auto start_time = std::chrono::high_resolution_clock::now();
     statistics = ScanStatistics();
+    unique_contents.clear();
+    content_index.clear();
+    inode_index.clear();
 
     std::vector<Match> all_matches;
 
     LOG_INFO_FMT("Starting scan of: {}", options.scan_path);
-    LOG_DEBUG_FMT("Using {} threads", options.num_threads);
 
     // получить все файлы для сканирования
+    auto walk_start = std::chrono::steady_clock::now();
     auto files_to_scan = getFilesToScan();
+    statistics.walk_time_seconds = secondsSince(walk_start);
     LOG_INFO_FMT("Found {} files to scan", files_to_scan.size());
 
+    if (telemetry) {
+        uint64_t total_bytes = 0;
+        for (const auto& entry : files_to_scan) {
+            total_bytes += entry.size;
+        }
+        telemetry->begin(files_to_scan.size(), total_bytes);
+    }
+
     // загрузить gitignore паттерны если нужно
     std::vector<std::string> gitignore_patterns;
     if (options.respect_gitignore) {
         gitignore_patterns = loadGitignorePatterns();
     }
 
-    // сканировать файлы
-    size_t current = 0;
-    std::mutex result_mutex;
-
-    for (const auto& file_path : files_to_scan) {
-        current++;
+    // результаты складываются по индексу файла, чтобы порядок не зависел от потоков
+    std::vector<std::vector<Match>> per_file(files_to_scan.size());
+    std::atomic<size_t> next_file{0};
 
-        // вызвать callback прогресса
-        if (progress_callback) {
-            progress_callback(current, files_to_scan.size());
-        }
+    auto worker = [&]() {
+        PhaseTimes times;
+        double busy_seconds = 0.0;
 
-        // пропустить, если игнорируется
-        if (options.respect_gitignore && 
-            isIgnoredByGitignore(file_path, gitignore_patterns)) {
-            LOG_DEBUG_FMT("Ignoring file: {}", file_path);
-            continue;
-        }
+        for (size_t index = next_file++; index < files_to_scan.size(); index = next_file++) {
+            if (cancelled()) {
+                break;
+            }
+            const auto& file_path = files_to_scan[index].path;
+            auto file_start = std::chrono::steady_clock::now();
+            TRACE_SCOPE_DETAIL("file", "scan", &file_path);
+
+            // пропустить, если игнорируется
+            if (options.respect_gitignore && 
+                isIgnoredByGitignore(file_path, gitignore_patterns)) {
+                LOG_DEBUG_FMT("Ignoring file: {}", file_path);
+            } else {
+                // сканировать файл
+                try {
+                    auto matches = options.deduplicate_content
+                        ? scanFileDeduplicated(file_path, matcher, times)
+                        : scanFileTimed(file_path, matcher, times);
+
+                    // известные находки отбрасываются до статистики и callback'ов
+                    size_t suppressed = options.baseline
+                        ? options.baseline->filter(matches, options.scan_path)
+                        : 0;
+
+                    {
+                        std::lock_guard<std::mutex> lock(stats_mutex);
+                        statistics.total_files_scanned++;
+                        statistics.baseline_suppressed += suppressed;
+                        statistics.recordMatches(matches);
+                    }
 
-        // сканировать файл
-        try {
-            auto matches = scanFile(file_path, matcher);
-            
-            {
-                std::lock_guard<std::mutex> lock(result_mutex);
-                all_matches.insert(all_matches.end(), matches.begin(), matches.end());
-                statistics.total_files_scanned++;
-                statistics.total_matches_found += matches.size();
-                
-                // подсчитать по severity
-                for (const auto& match : matches) {
-                    if (match.severity == "CRITICAL") {
-                        statistics.critical_count++;
-                    } else if (match.severity == "HIGH") {
-                        statistics.high_count++;
-                    } else if (match.severity == "MEDIUM") {
-                        statistics.medium_count++;
-                    } else if (match.severity == "LOW") {
-                        statistics.low_count++;
+                    // находка подтверждена - сразу отдать наружу
+                    if (match_callback) {
+                        for (const auto& match : matches) {
+                            match_callback(match);
+                        }
                     }
+
+                    per_file[index] = std::move(matches);
+                } catch (const std::exception& e) {
+                    LOG_WARN_FMT("Error scanning file {}: {}", file_path, e.what());
                 }
             }
-        } catch (const std::exception& e) {
-            LOG_WARN_FMT("Error scanning file {}: {}", file_path, e.what());
+
+            // только счетчики - отображение прогресса опрашивает их само
+            if (telemetry) {
+                telemetry->recordFile(files_to_scan[index].size, per_file[index].size());
+            }
+            busy_seconds += secondsSince(file_start);
         }
+
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        statistics.read_time_seconds += times.read_seconds;
+        statistics.match_time_seconds += times.match_seconds;
+        statistics.total_bytes_scanned += times.bytes;
+        statistics.thread_busy_seconds += busy_seconds;
+    };
+
+    size_t thread_count = std::min<size_t>(options.num_threads, files_to_scan.size());
+    LOG_DEBUG_FMT("Using {} threads", thread_count);
+    statistics.threads_used = std::max<size_t>(thread_count, 1);
+    auto workers_start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < thread_count; ++t) {
+        workers.emplace_back([&worker]() {
+            TraceRecorder::setThreadName("scan worker");
+            worker();
+        });
+    }
+    worker();  // текущий поток тоже работает
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    statistics.worker_time_seconds = secondsSince(workers_start);
+    statistics.cancelled = cancelled();
+
+    for (auto& matches : per_file) {
+        all_matches.insert(all_matches.end(),
+                           std::make_move_iterator(matches.begin()),
+                           std::make_move_iterator(matches.end()));
     }
 
     auto end_time = std::chrono::high_resolution_clock::now();
     statistics.scan_time_seconds = 
         std::chrono::duration<double>(end_time - start_time).count();
+    statistics.recordPeakRss();
 
+    if (telemetry) {
+        telemetry->finish();
+    }
+
+    if (statistics.cancelled) {
+        LOG_WARN_FMT("Scan cancelled after {} of {} files, findings are incomplete",
+                     statistics.total_files_scanned, files_to_scan.size());
+    }
     LOG_INFO_FMT("Scan completed in {:.2f} seconds", statistics.scan_time_seconds);
     LOG_INFO_FMT("Found {} matches", statistics.total_matches_found);
+    if (statistics.duplicate_files > 0) {
+        LOG_INFO_FMT("Skipped {} duplicate files ({} unique contents)",
+                     statistics.duplicate_files, unique_contents.size());
+    }
+    if (statistics.baseline_suppressed > 0) {
+        LOG_INFO_FMT("Suppressed {} findings known in baseline", statistics.baseline_suppressed);
+    }
 
     return all_matches;
 }
 
+std::vector<Match> FileScanner::scanFileDeduplicated(const std::string& file_path,
+                                                     const PatternMatcher& matcher,
+                                                     PhaseTimes& times) {
+    // hardlink'и: тот же (dev, inode) уже просканирован - даже не читать файл
+    struct stat st{};
+    bool linked = ::stat(file_path.c_str(), &st) == 0 && st.st_nlink > 1;
+    std::pair<uint64_t, uint64_t> inode_key{st.st_dev, st.st_ino};
+    if (linked) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = inode_index.find(inode_key);
+        if (it != inode_index.end()) {
+            return fanOut(it->second, file_path, true);
+        }
+    }
+
+    auto read_start = std::chrono::steady_clock::now();
+    std::string content = FileUtils::readFile(file_path);
+    times.read_seconds += secondsSince(read_start);
+    if (content.empty()) {
+        return {};
+    }
+    times.bytes += content.size();
+
+    // одинаковое содержимое сканируется один раз
+    std::pair<uint64_t, uint64_t> content_key{HashUtils::hash64(content), content.size()};
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = content_index.find(content_key);
+        if (it != content_index.end()) {
+            LOG_DEBUG_FMT("Duplicate content: {}", file_path);
+            if (linked) {
+                inode_index.emplace(inode_key, it->second);
+            }
+            return fanOut(it->second, file_path, true);
+        }
+    }
+
+    // сканирование - вне блокировки (одновременно встреченные копии могут
+    // просканироваться дважды, в кэш попадет первая, вторая считается дубликатом)
+    UniqueContent unique;
+    unique.line_count = std::count(content.begin(), content.end(), '\n') + 1;
+    auto match_start = std::chrono::steady_clock::now();
+    unique.matches = matcher.findMatches(content, file_path, options.file_budget, unique.outcome);
+    times.match_seconds += secondsSince(match_start);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto [it, inserted] = content_index.emplace(content_key, unique_contents.size());
+    if (inserted) {
+        unique_contents.push_back(std::move(unique));
+    }
+    if (linked) {
+        inode_index.emplace(inode_key, it->second);
+    }
+    return fanOut(it->second, file_path, !inserted);
+}
+
+std::vector<Match> FileScanner::fanOut(size_t index, const std::string& file_path, bool duplicate) {
+    const auto& unique = unique_contents[index];
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        statistics.total_lines_scanned += unique.line_count;
+        if (duplicate) {
+            statistics.duplicate_files++;
+        }
+        statistics.recordOutcome(file_path, unique.outcome);
+    }
+
+    std::vector<Match> matches = unique.matches;
+    for (auto& match : matches) {
+        match.file_path = file_path;
+    }
+    return matches;
+}
+
 std::vector<Match> FileScanner::scanFile(const std::string& file_path,
                                         const PatternMatcher& matcher) const {
+    PhaseTimes times;
+    return scanFileTimed(file_path, matcher, times);
+}
+
+std::vector<Match> FileScanner::scanFileTimed(const std::string& file_path,
+                                             const PatternMatcher& matcher,
+                                             PhaseTimes& times) const {
+    auto read_start = std::chrono::steady_clock::now();
     std::string content = FileUtils::readFile(file_path);
+    times.read_seconds += secondsSince(read_start);
     if (content.empty()) {
         return {};
     }
+    times.bytes += content.size();
 
     // подсчитать строки
     int line_count = std::count(content.begin(), content.end(), '\n') + 1;
-    statistics.total_lines_scanned += line_count;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        statistics.total_lines_scanned += line_count;
+    }
 
-    return matcher.findMatches(content, file_path);
+    auto match_start = std::chrono::steady_clock::now();
+    MatchOutcome outcome;
+    auto matches = matcher.findMatches(content, file_path, options.file_budget, outcome);
+    times.match_seconds += secondsSince(match_start);
+    if (outcome.partial) {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        statistics.recordOutcome(file_path, outcome);
+    }
+    return matches;
 }
 
-std::vector<std::string> FileScanner::getFilesToScan() {
-    std::vector<std::string> files;
+std::vector<Match> FileScanner::scanStream(int fd,
+                                          const std::string& source_name,
+                                          const PatternMatcher& matcher,
+                                          const std::function<void(const Match&)>& on_match) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    statistics = ScanStatistics();
+
+    std::vector<Match> all_matches;
+
+    LOG_INFO_FMT("Starting stream scan of: {}", source_name);
+    if (telemetry) {
+        telemetry->begin(1, 0);
+    }
+
+    std::string pending;                 // данные, еще не отданные на сканирование
+    std::vector<char> buffer(STREAM_READ_SIZE);
+    size_t line_base = 0;                // сколько полных строк уже просканировано
+    size_t column_base = 0;              // смещение колонки, если строка была разрезана
+    size_t total_lines = 0;
+    bool eof = false;
+
+    // просканировать блок и сдвинуть счетчики строк
+    auto process = [&](const std::string& chunk, bool ends_with_newline) {
+        if (chunk.empty()) {
+            return;
+        }
+
+        auto match_start = std::chrono::steady_clock::now();
+        MatchOutcome outcome;
+        auto matches = matcher.findMatches(chunk, source_name, options.file_budget, outcome);
+        statistics.match_time_seconds += secondsSince(match_start);
+        // бюджет действует на каждый блок, в отчет источник попадает один раз
+        if (statistics.partial_files.empty()) {
+            statistics.recordOutcome(source_name, outcome);
+        }
+        statistics.total_bytes_scanned += chunk.size();
+        for (auto& match : matches) {
+            if (match.line_number == 1) {
+                match.column_number += static_cast<int>(column_base);
+            }
+            match.line_number += static_cast<int>(line_base);
+        }
+        if (options.baseline) {
+            statistics.baseline_suppressed += options.baseline->filter(matches, "");
+        }
+        statistics.recordMatches(matches);
+        if (telemetry) {
+            telemetry->recordBytes(chunk.size(), matches.size());
+        }
+
+        if (on_match) {
+            for (const auto& match : matches) {
+                on_match(match);
+            }
+        } else {
+            all_matches.insert(all_matches.end(), matches.begin(), matches.end());
+        }
+
+        size_t newlines = std::count(chunk.begin(), chunk.end(), '\n');
+        line_base += newlines;
+        total_lines += newlines;
+        // блоки без перевода строки - это куски одной длинной строки
+        column_base = ends_with_newline ? 0 : column_base + chunk.size();
+    };
+
+    // сигнал отмены прерывает read() с EINTR - цикл выходит сразу
+    while (!eof && !cancelled()) {
+        auto read_start = std::chrono::steady_clock::now();
+        ssize_t n = ::read(fd, buffer.data(), buffer.size());
+        statistics.read_time_seconds += secondsSince(read_start);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR_FMT("Error reading stream {}: {}", source_name, std::strerror(errno));
+            break;
+        }
+        if (n == 0) {
+            eof = true;
+        } else {
+            pending.append(buffer.data(), static_cast<size_t>(n));
+        }
+
+        // отдать на сканирование все полные строки, что уже пришли
+        size_t last_nl = pending.rfind('\n');
+        if (last_nl != std::string::npos) {
+            process(pending.substr(0, last_nl + 1), true);
+            pending.erase(0, last_nl + 1);
+        }
+
+        // слишком длинная строка без перевода - сканировать принудительно
+        if (pending.size() >= STREAM_MAX_PENDING) {
+            LOG_DEBUG_FMT("Line in {} exceeds {} bytes, splitting", source_name, STREAM_MAX_PENDING);
+            process(pending, false);
+            pending.clear();
+        }
+    }
+
+    // остаток без завершающего перевода строки
+    process(pending, false);
+    if (column_base > 0) {
+        total_lines++;
+    }
+
+    statistics.total_files_scanned = 1;
+    statistics.total_lines_scanned = total_lines;
+    statistics.threads_used = 1;
+    statistics.cancelled = cancelled();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    statistics.scan_time_seconds =
+        std::chrono::duration<double>(end_time - start_time).count();
+    statistics.worker_time_seconds = statistics.scan_time_seconds;
+    // ожидание данных в read() - простой, а не работа
+    statistics.thread_busy_seconds = statistics.match_time_seconds;
+    statistics.recordPeakRss();
+
+    if (telemetry) {
+        telemetry->recordFile(0, 0);
+        telemetry->finish();
+    }
+
+    LOG_INFO_FMT("Stream scan completed in {:.2f} seconds", statistics.scan_time_seconds);
+    LOG_INFO_FMT("Found {} matches", statistics.total_matches_found);
+
+    return all_matches;
+}
+
+std::vector<FileScanner::FileEntry> FileScanner::getFilesToScan() {
+    TRACE_SCOPE("walk directory", "scan");
+    std::vector<FileEntry> files;
 
     try {
         if (!fs::exists(options.scan_path)) {
@@ -117,17 +443,24 @@ std::vector<std::string> FileScanner::getFilesToScan() {
             return files;
         }
 
+        auto add_entry = [&](const fs::directory_entry& entry) {
+            if (fs::is_regular_file(entry) && shouldScanFile(entry.path().string())) {
+                std::error_code ec;
+                uint64_t size = entry.file_size(ec);
+                files.push_back({entry.path().string(), ec ? 0 : size});
+            }
+        };
+
+        // после отмены обход прекращается - сканируются уже найденные файлы
         if (options.recursive) {
             for (const auto& entry : fs::recursive_directory_iterator(options.scan_path)) {
-                if (fs::is_regular_file(entry) && shouldScanFile(entry.path().string())) {
-                    files.push_back(entry.path().string());
-                }
+                if (cancelled()) break;
+                add_entry(entry);
             }
         } else {
             for (const auto& entry : fs::directory_iterator(options.scan_path)) {
-                if (fs::is_regular_file(entry) && shouldScanFile(entry.path().string())) {
-                    files.push_back(entry.path().string());
-                }
+                if (cancelled()) break;
+                add_entry(entry);
             }
         }
     } catch (const std::exception& e) {
@@ -138,6 +471,25 @@ std::vector<std::string> FileScanner::getFilesToScan() {
 }
 
 bool FileScanner::shouldScanFile(const std::string& file_path) const {
+    if (!shouldScanPath(file_path)) {
+        return false;
+    }
+
+    // при явном списке расширений проверка содержимого не нужна
+    if (!options.include_extensions.empty()) {
+        return true;
+    }
+
+    // проверить содержимое на null-байты, (бинарный файл)
+    if (isBinaryContent(file_path)) {
+        LOG_DEBUG_FMT("Skipping binary content: {}", file_path);
+        return false;
+    }
+
+    return true;
+}
+
+bool FileScanner::shouldScanPath(const std::string& file_path) const {
     std::string extension = FileUtils::getFileExtension(file_path);
     
     // список расширений для пропуска
@@ -209,17 +561,12 @@ bool FileScanner::shouldScanFile(const std::string& file_path) const {
         }
         return found;
     }
-    
-    // проверить содержимое на null-байты, (бинарный файл)
-    if (isBinaryContent(file_path)) {
-        LOG_DEBUG_FMT("Skipping binary content: {}", file_path);
-        return false;
-    }
 
     return true;
 }
 
 bool FileScanner::isBinaryContent(const std::string& file_path) const {
+    TRACE_SCOPE_DETAIL("binary check", "io", &file_path);
     std::ifstream file(file_path, std::ios::binary);
     if (!file.is_open()) {
         return false;
@@ -228,23 +575,28 @@ bool FileScanner::isBinaryContent(const std::string& file_path) const {
     // прочитать первые 512 байт
     char buffer[512];
     file.read(buffer, sizeof(buffer));
-    std::streamsize bytes_read = file.gcount();
+    
+    return isBinaryData(buffer, static_cast<size_t>(file.gcount()));
+}
+
+bool FileScanner::isBinaryData(const char* data, size_t size) {
+    size_t bytes_read = std::min<size_t>(size, 512);
     
     if (bytes_read == 0) {
         return false;
     }
     
     // если есть хотя бы один null-байт - точно бинарный
-    for (std::streamsize i = 0; i < bytes_read; ++i) {
-        if (buffer[i] == '\0') {
+    for (size_t i = 0; i < bytes_read; ++i) {
+        if (data[i] == '\0') {
             return true;  // Бинарный файл
         }
     }
     
     // подсчитать непечатные символы
-    int non_printable = 0;
-    for (std::streamsize i = 0; i < bytes_read; ++i) {
-        unsigned char c = static_cast<unsigned char>(buffer[i]);
+    size_t non_printable = 0;
+    for (size_t i = 0; i < bytes_read; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
         if (c < 32 && c != '\n' && c != '\r' && c != '\t') {
             non_printable++;
         } else if (c > 127 && c < 160) {
@@ -289,6 +641,22 @@ std::vector<std::string> FileScanner::loadGitignorePatterns() {
     return patterns;
 }
 
+bool FileScanner::isIgnored(const std::string& path) {
+    for (const auto& exclude : options.exclude_patterns) {
+        if (path.find(exclude) != std::string::npos) {
+            return true;
+        }
+    }
+    if (!options.respect_gitignore) {
+        return false;
+    }
+    if (!gitignore_loaded) {
+        gitignore_cache = loadGitignorePatterns();
+        gitignore_loaded = true;
+    }
+    return isIgnoredByGitignore(path, gitignore_cache);
+}
+
 bool FileScanner::isIgnoredByGitignore(const std::string& file_path,
                                      const std::vector<std::string>& gitignore_patterns) const {
     for (const auto& pattern : gitignore_patterns) {
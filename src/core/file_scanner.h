@@ -3,7 +3,15 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <cstdint>
 #include "pattern_matcher.h"
+#include "baseline.h"
+#include "scan_telemetry.h"
+#include "cancellation.h"
 
 /**
  * @struct ScanOptions
@@ -16,6 +24,20 @@ struct ScanOptions {
     std::vector<std::string> exclude_patterns;    ///< Паттерны для исключения (e.g., "node_modules/*")
     bool respect_gitignore = true;   ///< Использовать .gitignore
     int num_threads = 0;             ///< Количество потоков (0 = автоматически)
+    bool deduplicate_content = true; ///< Сканировать одинаковое содержимое (и hardlink'и) один раз
+    std::shared_ptr<const Baseline> baseline;  ///< Известные находки (не попадают в результат)
+    MatchBudget file_budget{10000.0, 16384};   ///< Бюджет поиска на файл (см. MatchBudget)
+    std::shared_ptr<CancellationToken> cancel; ///< Отмена сканирования (nullptr - не отменяется)
+};
+
+/**
+ * @struct PartialScan
+ * @brief Файл, просканированный не полностью (превышен бюджет)
+ */
+struct PartialScan {
+    std::string file_path;
+    std::string reason;
+    PartialCause cause = PartialCause::TimeBudget;
 };
 
 /**
@@ -31,6 +53,72 @@ struct ScanStatistics {
     size_t low_count = 0;
     double scan_time_seconds = 0.0;
     size_t total_lines_scanned = 0;
+    size_t duplicate_files = 0;      ///< Файлы-дубликаты (находки скопированы, повторно не сканировались)
+    size_t baseline_suppressed = 0;  ///< Находки, подавленные baseline'ом
+    uint64_t total_bytes_scanned = 0;   ///< Прочитано и просканировано байт
+    std::map<std::string, size_t> pattern_counts;  ///< Находки по паттернам
+    std::vector<PartialScan> partial_files;        ///< Файлы, просканированные частично
+    bool cancelled = false;             ///< Сканирование отменено - находки неполные
+
+    // длительность фаз; чтение и поиск суммируются по всем рабочим потокам
+    double walk_time_seconds = 0.0;     ///< Обход директорий / истории
+    double read_time_seconds = 0.0;     ///< Чтение файлов
+    double match_time_seconds = 0.0;    ///< Поиск паттернов
+    double export_time_seconds = 0.0;   ///< Запись отчета (заполняет вызывающий код)
+
+    uint64_t peak_rss_bytes = 0;        ///< Пиковый RSS процесса
+    size_t threads_used = 0;            ///< Рабочих потоков
+    double thread_busy_seconds = 0.0;   ///< Суммарное время потоков за обработкой файлов
+    double worker_time_seconds = 0.0;   ///< Время параллельной фазы (wall clock)
+
+    /**
+     * Загрузка рабочих потоков: доля времени параллельной фазы, занятая работой
+     */
+    double threadUtilization() const {
+        double capacity = threads_used * worker_time_seconds;
+        return capacity > 0 ? std::min(1.0, thread_busy_seconds / capacity) : 0.0;
+    }
+
+    /**
+     * Запомнить текущий пиковый RSS процесса
+     */
+    void recordPeakRss();
+
+    /**
+     * Учесть файл, просканированный частично (если outcome.partial)
+     */
+    void recordOutcome(const std::string& file_path, const MatchOutcome& outcome) {
+        if (outcome.partial) {
+            partial_files.push_back({file_path, outcome.reason, outcome.cause});
+        }
+    }
+
+    /**
+     * Сколько файлов просканировано частично по данной причине
+     */
+    size_t partialCount(PartialCause cause) const {
+        return std::count_if(partial_files.begin(), partial_files.end(),
+                             [cause](const PartialScan& partial) { return partial.cause == cause; });
+    }
+
+    /**
+     * Учесть найденные совпадения (общее количество и разбивка по severity)
+     */
+    void recordMatches(const std::vector<Match>& matches) {
+        total_matches_found += matches.size();
+        for (const auto& match : matches) {
+            pattern_counts[match.pattern_name]++;
+            if (match.severity == "CRITICAL") {
+                critical_count++;
+            } else if (match.severity == "HIGH") {
+                high_count++;
+            } else if (match.severity == "MEDIUM") {
+                medium_count++;
+            } else if (match.severity == "LOW") {
+                low_count++;
+            }
+        }
+    }
 };
 
 /**
@@ -57,6 +145,21 @@ public:
      */
     std::vector<Match> scanFile(const std::string& file_path,
                                 const PatternMatcher& matcher) const;
+
+    /**
+     * Сканировать поток (stdin, pipe) по мере поступления данных
+     * Память ограничена размером одного блока: данные режутся по границам строк,
+     * сканируются и сразу отбрасываются.
+     * @param fd Файловый дескриптор для чтения
+     * @param source_name Имя источника для отчета (e.g., "<stdin>")
+     * @param matcher Объект PatternMatcher
+     * @param on_match Callback для каждой находки (если пустой - находки накапливаются)
+     * @return Вектор совпадений (пустой, если задан on_match)
+     */
+    std::vector<Match> scanStream(int fd,
+                                  const std::string& source_name,
+                                  const PatternMatcher& matcher,
+                                  const std::function<void(const Match&)>& on_match);
     
     /**
      * Получить статистику последнего сканирования
@@ -64,27 +167,109 @@ public:
     const ScanStatistics& getStatistics() const { return statistics; }
 
     /**
-     * Установить callback для прогресса
-     * @param callback Функция: (current_file_index, total_files)
+     * Проверить путь по расширению и фильтрам пользователя (без чтения файла)
+     */
+    bool shouldScanPath(const std::string& file_path) const;
+
+    /**
+     * Проверить, нужно ли сканировать файл (фильтры пути и проверка содержимого на бинарность)
      */
-    void setProgressCallback(std::function<void(size_t, size_t)> callback) {
-        progress_callback = callback;
+    bool shouldScanFile(const std::string& file_path) const;
+
+    /**
+     * Проверить путь (файл или директорию) по .gitignore корня и исключениям пользователя
+     * Для путей, найденных вне обхода (режим наблюдения); .gitignore читается один раз.
+     */
+    bool isIgnored(const std::string& path);
+
+    /**
+     * Проверить, похожи ли данные на бинарные (null-байты, много непечатных)
+     * @param data Начало данных (достаточно первых 512 байт)
+     * @param size Размер данных
+     */
+    static bool isBinaryData(const char* data, size_t size);
+
+    /**
+     * Установить телеметрию прогресса (обновляется рабочими потоками без блокировок)
+     */
+    void setTelemetry(std::shared_ptr<ScanTelemetry> scan_telemetry) {
+        telemetry = std::move(scan_telemetry);
+    }
+
+    /**
+     * Установить callback для находок
+     * Вызывается из рабочих потоков сразу после сканирования файла,
+     * callback должен быть потокобезопасным.
+     */
+    void setMatchCallback(std::function<void(const Match&)> callback) {
+        match_callback = callback;
     }
 
 private:
+    /**
+     * Результат сканирования одного уникального содержимого
+     */
+    struct UniqueContent {
+        std::vector<Match> matches;   ///< Находки (с путем первого файла)
+        size_t line_count = 0;
+        MatchOutcome outcome;         ///< Было ли содержимое просканировано частично
+    };
+
+    /**
+     * Файл для сканирования и его размер (для телеметрии)
+     */
+    struct FileEntry {
+        std::string path;
+        uint64_t size = 0;
+    };
+
+    /**
+     * Время фаз одного рабочего потока (сливается в statistics в конце)
+     */
+    struct PhaseTimes {
+        double read_seconds = 0.0;
+        double match_seconds = 0.0;
+        uint64_t bytes = 0;
+    };
+
     ScanOptions options;
     mutable ScanStatistics statistics;
-    std::function<void(size_t, size_t)> progress_callback;
+    mutable std::mutex stats_mutex;     ///< Защищает statistics от рабочих потоков
+    std::shared_ptr<ScanTelemetry> telemetry;
+    std::function<void(const Match&)> match_callback;
+
+    std::vector<UniqueContent> unique_contents;
+    std::map<std::pair<uint64_t, uint64_t>, size_t> content_index;  ///< (хэш, размер) -> unique_contents
+    std::map<std::pair<uint64_t, uint64_t>, size_t> inode_index;    ///< (dev, inode) -> unique_contents
+    std::mutex cache_mutex;             ///< Защищает кэш дедупликации
+
+    std::vector<std::string> gitignore_cache;   ///< .gitignore корня для isIgnored()
+    bool gitignore_loaded = false;
 
     /**
-     * Получить все файлы для сканирования
+     * Сканировать файл с дедупликацией по (dev, inode) и хэшу содержимого
+     * Повторное содержимое не читается/не сканируется, находки копируются с новым путем.
      */
-    std::vector<std::string> getFilesToScan();
+    std::vector<Match> scanFileDeduplicated(const std::string& file_path,
+                                            const PatternMatcher& matcher,
+                                            PhaseTimes& times);
 
     /**
-     * Проверить, нужно ли сканировать файл (по расширению, исключениям и т.д.)
+     * Прочитать и просканировать файл с учетом времени фаз
      */
-    bool shouldScanFile(const std::string& file_path) const;
+    std::vector<Match> scanFileTimed(const std::string& file_path,
+                                     const PatternMatcher& matcher,
+                                     PhaseTimes& times) const;
+
+    /**
+     * Скопировать находки уникального содержимого для конкретного пути
+     */
+    std::vector<Match> fanOut(size_t content_index, const std::string& file_path, bool duplicate);
+
+    /**
+     * Получить все файлы для сканирования
+     */
+    std::vector<FileEntry> getFilesToScan();
 
     /**
      * Загрузить .gitignore паттерны
@@ -97,6 +282,11 @@ private:
     bool isIgnoredByGitignore(const std::string& file_path,
                              const std::vector<std::string>& gitignore_patterns) const;
 
+    /**
+     * Запрошена ли отмена (options.cancel)
+     */
+    bool cancelled() const { return options.cancel && options.cancel->isCancelled(); }
+
     /**
      * Проверить, является ли файл бинарным
      */
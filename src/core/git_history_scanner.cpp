@@ -0,0 +1,276 @@
+#include "core/git_history_scanner.h"
+#include "utils/logger.h"
+#include "utils/trace_recorder.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+GitHistoryScanner::GitHistoryScanner(ScanOptions opts)
+    : options(std::move(opts)), filter(options) {
+    options.file_budget.cancel = options.cancel.get();
+}
+
+std::vector<Match> GitHistoryScanner::scan(const PatternMatcher& matcher) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    statistics = ScanStatistics();
+    seen_trees.clear();
+    seen_blobs.clear();
+
+    std::vector<Match> all_matches;
+
+    GitObjectStore store;
+    if (!store.open(options.scan_path)) {
+        return all_matches;
+    }
+
+    LOG_INFO_FMT("Starting git history scan of: {}", store.getGitDir());
+
+    auto commits = collectCommits(store);
+    LOG_INFO_FMT("Found {} commits to scan", commits.size());
+
+    if (telemetry) {
+        telemetry->begin(0, 0);
+    }
+
+    // от старых коммитов к новым: blob приписывается первому коммиту, где он появился
+    for (const auto& commit : commits) {
+        if (cancelled()) {
+            break;
+        }
+        scanTree(store, commit.tree, "", commit.oid, matcher, all_matches);
+    }
+    statistics.cancelled = cancelled();
+
+    if (telemetry) {
+        telemetry->finish();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    statistics.scan_time_seconds =
+        std::chrono::duration<double>(end_time - start_time).count();
+
+    // обход истории однопоточный: все, что не чтение blob'ов и не поиск, - обход
+    statistics.walk_time_seconds = std::max(0.0, statistics.scan_time_seconds -
+        statistics.read_time_seconds - statistics.match_time_seconds);
+    statistics.threads_used = 1;
+    statistics.worker_time_seconds = statistics.scan_time_seconds;
+    statistics.thread_busy_seconds = statistics.scan_time_seconds;
+    statistics.recordPeakRss();
+
+    if (statistics.cancelled) {
+        LOG_WARN("History scan cancelled, findings are incomplete");
+    }
+    LOG_INFO_FMT("History scan completed in {:.2f} seconds ({} unique blobs, {} trees)",
+                 statistics.scan_time_seconds, seen_blobs.size(), seen_trees.size());
+    LOG_INFO_FMT("Found {} matches", statistics.total_matches_found);
+    if (statistics.baseline_suppressed > 0) {
+        LOG_INFO_FMT("Suppressed {} findings known in baseline", statistics.baseline_suppressed);
+    }
+
+    return all_matches;
+}
+
+std::vector<GitHistoryScanner::CommitInfo> GitHistoryScanner::collectCommits(GitObjectStore& store) {
+    std::unordered_map<std::string, CommitInfo> commits;
+    std::unordered_set<std::string> visited;
+    std::vector<std::string> tips;
+    std::deque<std::string> queue;
+
+    for (const auto& ref : store.listRefs()) {
+        queue.push_back(ref.oid);
+    }
+
+    while (!queue.empty()) {
+        std::string oid = queue.front();
+        queue.pop_front();
+        if (!visited.insert(oid).second) {
+            continue;
+        }
+
+        GitObject object;
+        if (!store.readObject(oid, object)) {
+            LOG_WARN_FMT("Missing object in history: {}", oid);
+            continue;
+        }
+
+        // аннотированный тег - перейти к объекту, на который он указывает
+        if (object.type == GitObjectType::Tag) {
+            if (object.data.rfind("object ", 0) == 0 && object.data.size() >= 47) {
+                queue.push_back(object.data.substr(7, 40));
+            }
+            continue;
+        }
+        if (object.type != GitObjectType::Commit) {
+            continue;
+        }
+
+        CommitInfo info;
+        info.oid = oid;
+
+        // заголовки коммита идут до первой пустой строки
+        size_t pos = 0;
+        while (pos < object.data.size()) {
+            size_t eol = object.data.find('\n', pos);
+            if (eol == std::string::npos) eol = object.data.size();
+            if (eol == pos) break;
+
+            std::string line = object.data.substr(pos, eol - pos);
+            if (line.rfind("tree ", 0) == 0) {
+                info.tree = line.substr(5, 40);
+            } else if (line.rfind("parent ", 0) == 0) {
+                info.parents.push_back(line.substr(7, 40));
+                queue.push_back(info.parents.back());
+            } else if (line.rfind("committer ", 0) == 0) {
+                // "committer Name <email> <timestamp> <tz>"
+                size_t gt = line.rfind('>');
+                if (gt != std::string::npos) {
+                    try {
+                        info.timestamp = std::stoll(line.substr(gt + 1));
+                    } catch (...) {
+                        info.timestamp = 0;
+                    }
+                }
+            }
+            pos = eol + 1;
+        }
+
+        tips.push_back(oid);
+        commits.emplace(oid, std::move(info));
+    }
+
+    // старые ветки обходятся первыми, чтобы общие blob'ы приписывались ранним коммитам
+    std::stable_sort(tips.begin(), tips.end(), [&](const std::string& a, const std::string& b) {
+        return commits[a].timestamp < commits[b].timestamp;
+    });
+
+    // итеративный DFS в post-order: коммит выдается после всех своих родителей
+    std::vector<CommitInfo> ordered;
+    std::unordered_set<std::string> emitted;
+    for (const auto& tip : tips) {
+        std::vector<std::pair<std::string, size_t>> stack{{tip, 0}};
+        while (!stack.empty()) {
+            auto& [oid, next_parent] = stack.back();
+            auto it = commits.find(oid);
+            if (it == commits.end() || emitted.count(oid)) {
+                stack.pop_back();
+                continue;
+            }
+            if (next_parent < it->second.parents.size()) {
+                std::string parent = it->second.parents[next_parent++];
+                if (!emitted.count(parent)) {
+                    stack.emplace_back(parent, 0);
+                }
+                continue;
+            }
+            emitted.insert(oid);
+            if (!it->second.tree.empty()) {
+                ordered.push_back(it->second);
+            }
+            stack.pop_back();
+        }
+    }
+
+    return ordered;
+}
+
+void GitHistoryScanner::scanTree(GitObjectStore& store, const std::string& tree_oid,
+                                 const std::string& prefix, const std::string& commit_oid,
+                                 const PatternMatcher& matcher, std::vector<Match>& matches) {
+    // все blob'ы уже просмотренного дерева уже просканированы
+    // (исключения пользователя зависят от пути, тогда дерево различается и по префиксу)
+    std::string tree_key = options.exclude_patterns.empty() ? tree_oid : tree_oid + ":" + prefix;
+    if (!seen_trees.insert(tree_key).second) {
+        return;
+    }
+
+    GitObject tree;
+    if (!store.readObject(tree_oid, tree) || tree.type != GitObjectType::Tree) {
+        LOG_WARN_FMT("Cannot read tree {}", tree_oid);
+        return;
+    }
+
+    // записи дерева: "<mode> <name>\0<20 байт SHA-1>"
+    size_t pos = 0;
+    const std::string& data = tree.data;
+    while (pos < data.size() && !cancelled()) {
+        size_t space = data.find(' ', pos);
+        size_t nul = data.find('\0', space == std::string::npos ? pos : space);
+        if (space == std::string::npos || nul == std::string::npos || nul + 21 > data.size()) {
+            LOG_WARN_FMT("Malformed tree {}", tree_oid);
+            return;
+        }
+
+        std::string mode = data.substr(pos, space - pos);
+        std::string name = data.substr(space + 1, nul - space - 1);
+        std::string oid = GitObjectStore::toHex(reinterpret_cast<const unsigned char*>(data.data() + nul + 1));
+        pos = nul + 21;
+
+        std::string path = prefix.empty() ? name : prefix + "/" + name;
+
+        if (mode == "40000") {
+            scanTree(store, oid, path, commit_oid, matcher, matches);
+            continue;
+        }
+
+        // submodule (160000) и symlink (120000) не содержат данных для сканирования
+        if (mode == "160000" || mode == "120000") {
+            continue;
+        }
+
+        if (seen_blobs.count(oid) || !filter.shouldScanPath(path)) {
+            continue;
+        }
+        seen_blobs.insert(oid);
+
+        TRACE_SCOPE_DETAIL("blob", "scan", &path);
+        GitObject blob;
+        auto read_start = std::chrono::steady_clock::now();
+        bool read_ok;
+        {
+            TRACE_SCOPE_DETAIL("read blob", "io", &path);
+            read_ok = store.readObject(oid, blob);
+        }
+        statistics.read_time_seconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - read_start).count();
+        if (!read_ok || blob.type != GitObjectType::Blob) {
+            LOG_WARN_FMT("Cannot read blob {} ({})", oid, path);
+            continue;
+        }
+        if (blob.data.empty() || FileScanner::isBinaryData(blob.data.data(), blob.data.size())) {
+            continue;
+        }
+
+        statistics.total_files_scanned++;
+        statistics.total_lines_scanned += std::count(blob.data.begin(), blob.data.end(), '\n') + 1;
+        statistics.total_bytes_scanned += blob.data.size();
+
+        auto match_start = std::chrono::steady_clock::now();
+        MatchOutcome outcome;
+        auto blob_matches = matcher.findMatches(blob.data, path, options.file_budget, outcome);
+        statistics.match_time_seconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - match_start).count();
+        if (outcome.partial) {
+            outcome.reason += " (commit " + commit_oid + ")";
+            statistics.recordOutcome(path, outcome);
+        }
+        for (auto& match : blob_matches) {
+            match.commit = commit_oid;
+        }
+        // пути в истории уже относительны корню репозитория
+        if (options.baseline) {
+            statistics.baseline_suppressed += options.baseline->filter(blob_matches, "");
+        }
+        statistics.recordMatches(blob_matches);
+        if (match_callback) {
+            for (const auto& match : blob_matches) {
+                match_callback(match);
+            }
+        }
+        if (telemetry) {
+            telemetry->recordFile(blob.data.size(), blob_matches.size());
+        }
+        matches.insert(matches.end(), blob_matches.begin(), blob_matches.end());
+    }
+}
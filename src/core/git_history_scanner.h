@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include "pattern_matcher.h"
+#include "file_scanner.h"
+#include "utils/git_object_store.h"
+
+/**
+ * @class GitHistoryScanner
+ * @brief Сканирование всей истории git-репозитория напрямую по объектной базе
+ *
+ * Коммиты обходятся от старых к новым, каждый уникальный blob сканируется
+ * ровно один раз и приписывается коммиту и пути, где он появился впервые.
+ * Уже просмотренные деревья пропускаются целиком.
+ */
+class GitHistoryScanner {
+public:
+    explicit GitHistoryScanner(ScanOptions options);
+    ~GitHistoryScanner() = default;
+
+    /**
+     * Просканировать историю репозитория options.scan_path
+     * @param matcher Объект PatternMatcher с загруженными паттернами
+     * @return Вектор найденных совпадений (Match::commit заполнен)
+     */
+    std::vector<Match> scan(const PatternMatcher& matcher);
+
+    /**
+     * Получить статистику последнего сканирования
+     */
+    const ScanStatistics& getStatistics() const { return statistics; }
+
+    /**
+     * Установить callback для находок (вызывается сразу после сканирования blob'а)
+     */
+    void setMatchCallback(std::function<void(const Match&)> callback) {
+        match_callback = callback;
+    }
+
+    /**
+     * Установить телеметрию прогресса (объем истории заранее неизвестен)
+     */
+    void setTelemetry(std::shared_ptr<ScanTelemetry> scan_telemetry) {
+        telemetry = std::move(scan_telemetry);
+    }
+
+private:
+    struct CommitInfo {
+        std::string oid;
+        std::string tree;
+        std::vector<std::string> parents;
+        long long timestamp = 0;
+    };
+
+    ScanOptions options;
+    ScanStatistics statistics;
+    FileScanner filter;     ///< Используется для фильтров путей (расширения, исключения)
+    std::function<void(const Match&)> match_callback;
+    std::shared_ptr<ScanTelemetry> telemetry;
+
+    std::unordered_set<std::string> seen_trees;
+    std::unordered_set<std::string> seen_blobs;
+
+    /**
+     * Собрать все достижимые из ссылок коммиты в топологическом порядке
+     * (родители всегда раньше потомков)
+     */
+    std::vector<CommitInfo> collectCommits(GitObjectStore& store);
+
+    /**
+     * Рекурсивно обойти дерево и просканировать новые blob'ы
+     */
+    void scanTree(GitObjectStore& store, const std::string& tree_oid,
+                  const std::string& prefix, const std::string& commit_oid,
+                  const PatternMatcher& matcher, std::vector<Match>& matches);
+
+    /**
+     * Запрошена ли отмена (options.cancel)
+     */
+    bool cancelled() const { return options.cancel && options.cancel->isCancelled(); }
+};
@@ -0,0 +1,365 @@
+#include "core/pattern_bundle.h"
+#include "utils/file_utils.h"
+#include "utils/hash_utils.h"
+#include "utils/output_sink.h"
+#include "utils/logger.h"
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+using namespace PatternBundle;
+
+namespace {
+    uint64_t align8(uint64_t value) {
+        return (value + 7) & ~uint64_t(7);
+    }
+
+    /**
+     * Таблица строк без повторов (severity, якоря повторяются у многих паттернов)
+     */
+    class StringTable {
+    public:
+        uint32_t intern(const std::string& str) {
+            auto [it, inserted] = ids.emplace(str, static_cast<uint32_t>(strings.size()));
+            if (inserted) {
+                strings.push_back(str);
+                bytes += str.size();
+            }
+            return it->second;
+        }
+
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, uint32_t> ids;
+        uint64_t bytes = 0;
+    };
+
+    void writePadding(OutputSink& sink, uint64_t written) {
+        static const char zeros[8] = {0};
+        uint64_t padding = align8(written) - written;
+        if (padding > 0) {
+            sink.write(zeros, padding);
+        }
+    }
+}
+
+// ============================================================================
+// PatternBundleWriter
+// ============================================================================
+
+bool PatternBundleWriter::compile(const std::string& config_path, const std::string& bundle_path,
+                                  const RegexCostBudget& budget) {
+    try {
+        if (!FileUtils::fileExists(config_path)) {
+            LOG_ERROR_FMT("Cannot open patterns config: {}", config_path);
+            return false;
+        }
+        std::string source = FileUtils::readFile(config_path);
+
+        // здесь ошибка в JSON - ошибка, а не откат на встроенные паттерны
+        PatternMatcher matcher;
+        matcher.setCostBudget(budget);
+        if (!matcher.loadFromJson(json::parse(source))) {
+            LOG_ERROR_FMT("No patterns to compile in {}", config_path);
+            return false;
+        }
+
+        return write(matcher, source, bundle_path);
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error compiling patterns: {}", e.what());
+        return false;
+    }
+}
+
+bool PatternBundleWriter::write(const PatternMatcher& matcher, const std::string& source,
+                                const std::string& bundle_path) {
+    try {
+        const auto& patterns = matcher.getPatterns();
+
+        StringTable table;
+        std::vector<Record> records;
+        std::vector<uint32_t> anchor_ids;
+        records.reserve(patterns.size());
+
+        for (const auto& pattern : patterns) {
+            Record record{};
+            record.name = table.intern(pattern.name);
+            record.regex = pattern.regex_source.empty() ? NO_STRING : table.intern(pattern.regex_source);
+            record.severity = table.intern(pattern.severity);
+            record.description = table.intern(pattern.description);
+            record.regex_flags = static_cast<uint32_t>(pattern.regex.flags());
+            record.flags = 0;
+            if (pattern.use_entropy) {
+                record.flags |= FLAG_USE_ENTROPY;
+            }
+            if (!pattern.enabled) {
+                record.flags |= FLAG_DISABLED;
+            }
+            record.first_anchor = static_cast<uint32_t>(anchor_ids.size());
+            record.anchor_count = static_cast<uint32_t>(pattern.anchors.size());
+            record.entropy_threshold = pattern.entropy_threshold;
+            for (const auto& anchor : pattern.anchors) {
+                anchor_ids.push_back(table.intern(anchor));
+            }
+            records.push_back(record);
+        }
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.byte_order = BYTE_ORDER_MARK;
+        header.source_hash = HashUtils::hash64(source);
+        header.source_size = source.size();
+        header.pattern_count = records.size();
+        header.string_count = table.strings.size();
+        header.anchor_count = anchor_ids.size();
+
+        // раскладка секций
+        uint64_t offset = sizeof(Header);
+        header.string_offsets_offset = offset;
+        offset += (table.strings.size() + 1) * sizeof(uint64_t);
+        header.string_data_offset = offset;
+        offset = align8(offset + table.bytes);
+        header.records_offset = offset;
+        offset += records.size() * sizeof(Record);
+        header.anchors_offset = offset;
+
+        // бандл может быть открыт работающим сервером - замена через rename
+        std::string tmp_path = bundle_path + ".tmp";
+        {
+            auto sink = FileSink::open(tmp_path);
+            if (!sink) {
+                LOG_ERROR_FMT("Cannot open file for writing: {}", tmp_path);
+                return false;
+            }
+
+            sink->write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            std::vector<uint64_t> offsets;
+            offsets.reserve(table.strings.size() + 1);
+            uint64_t position = 0;
+            for (const auto& str : table.strings) {
+                offsets.push_back(position);
+                position += str.size();
+            }
+            offsets.push_back(position);
+            sink->write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+            for (const auto& str : table.strings) {
+                sink->write(str);
+            }
+            writePadding(*sink, table.bytes);
+
+            sink->write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+            sink->write(reinterpret_cast<const char*>(anchor_ids.data()), anchor_ids.size() * sizeof(uint32_t));
+            sink->flush();
+            if (sink->failed()) {
+                LOG_ERROR_FMT("Error writing pattern bundle: {}", tmp_path);
+                return false;
+            }
+        }
+        fs::rename(tmp_path, bundle_path);
+
+        LOG_INFO_FMT("Compiled {} patterns into {}", records.size(), bundle_path);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error writing pattern bundle: {}", e.what());
+        return false;
+    }
+}
+
+// ============================================================================
+// PatternBundleReader
+// ============================================================================
+
+PatternBundleReader::~PatternBundleReader() {
+    close();
+}
+
+void PatternBundleReader::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), data_size);
+    }
+    data = nullptr;
+    data_size = 0;
+    header = nullptr;
+    string_offsets = nullptr;
+    string_data = nullptr;
+    records = nullptr;
+    anchors = nullptr;
+}
+
+bool PatternBundleReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_DEBUG_FMT("No pattern bundle at {}", path);
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        LOG_WARN_FMT("Not a pattern bundle: {}", path);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        LOG_WARN_FMT("Cannot map pattern bundle: {}", path);
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    data_size = static_cast<size_t>(st.st_size);
+    header = reinterpret_cast<const Header*>(data);
+
+    if (!validate()) {
+        LOG_WARN_FMT("Corrupt or unsupported pattern bundle: {}", path);
+        close();
+        return false;
+    }
+
+    string_offsets = reinterpret_cast<const uint64_t*>(data + header->string_offsets_offset);
+    string_data = reinterpret_cast<const char*>(data + header->string_data_offset);
+    records = reinterpret_cast<const Record*>(data + header->records_offset);
+    anchors = reinterpret_cast<const uint32_t*>(data + header->anchors_offset);
+    return true;
+}
+
+bool PatternBundleReader::validate() const {
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    if (header->version != FORMAT_VERSION || header->byte_order != BYTE_ORDER_MARK) {
+        return false;
+    }
+
+    // все секции должны лежать внутри файла и быть выровнены
+    const uint64_t count = header->pattern_count;
+    const uint64_t strings = header->string_count;
+    const uint64_t anchor_total = header->anchor_count;
+    if (count > data_size || strings > data_size || anchor_total > data_size ||
+        header->string_offsets_offset > data_size || header->string_data_offset > data_size ||
+        header->records_offset > data_size || header->anchors_offset > data_size) {
+        return false;
+    }
+
+    uint64_t offsets_end = header->string_offsets_offset + (strings + 1) * sizeof(uint64_t);
+    if (header->string_offsets_offset % 8 != 0 || offsets_end > data_size ||
+        header->string_data_offset < offsets_end) {
+        return false;
+    }
+
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + header->string_offsets_offset);
+    if (offsets[strings] > data_size || header->string_data_offset + offsets[strings] > data_size) {
+        return false;
+    }
+    for (uint64_t i = 0; i < strings; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+
+    if (header->records_offset % 8 != 0 || header->records_offset + count * sizeof(Record) > data_size ||
+        header->anchors_offset % 4 != 0 ||
+        header->anchors_offset + anchor_total * sizeof(uint32_t) > data_size) {
+        return false;
+    }
+
+    // индексы строк и якорей не должны выходить за свои таблицы
+    const Record* recs = reinterpret_cast<const Record*>(data + header->records_offset);
+    for (uint64_t i = 0; i < count; ++i) {
+        const Record& record = recs[i];
+        if (record.name >= strings || record.severity >= strings || record.description >= strings ||
+            (record.regex >= strings && record.regex != NO_STRING) ||
+            uint64_t(record.first_anchor) + record.anchor_count > anchor_total) {
+            return false;
+        }
+    }
+    const uint32_t* ids = reinterpret_cast<const uint32_t*>(data + header->anchors_offset);
+    for (uint64_t i = 0; i < anchor_total; ++i) {
+        if (ids[i] >= strings) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string PatternBundleReader::getString(uint32_t id) const {
+    if (!header || id >= header->string_count) {
+        return "";
+    }
+    return std::string(string_data + string_offsets[id],
+                       string_offsets[id + 1] - string_offsets[id]);
+}
+
+bool PatternBundleReader::isFreshFor(const std::string& source) const {
+    return header && header->source_size == source.size() &&
+           header->source_hash == HashUtils::hash64(source);
+}
+
+bool PatternBundleReader::loadInto(PatternMatcher& matcher) const {
+    if (!header || header->pattern_count == 0) {
+        return false;
+    }
+
+    try {
+        std::vector<Pattern> loaded;
+        loaded.reserve(header->pattern_count);
+        for (uint64_t i = 0; i < header->pattern_count; ++i) {
+            const Record& record = records[i];
+            Pattern pattern;
+            pattern.name = getString(record.name);
+            pattern.severity = getString(record.severity);
+            pattern.description = getString(record.description);
+            pattern.use_entropy = (record.flags & FLAG_USE_ENTROPY) != 0;
+            pattern.enabled = (record.flags & FLAG_DISABLED) == 0;
+            pattern.entropy_threshold = record.entropy_threshold;
+            for (uint32_t a = 0; a < record.anchor_count; ++a) {
+                pattern.anchors.push_back(getString(anchors[record.first_anchor + a]));
+            }
+            if (record.regex != NO_STRING) {
+                pattern.regex_source = getString(record.regex);
+                pattern.regex = std::regex(pattern.regex_source,
+                                           static_cast<std::regex::flag_type>(record.regex_flags));
+            }
+            loaded.push_back(std::move(pattern));
+        }
+
+        matcher.clearPatterns();
+        for (const auto& pattern : loaded) {
+            matcher.addPattern(pattern);
+        }
+        return true;
+    } catch (const std::regex_error& e) {
+        LOG_WARN_FMT("Pattern bundle has an invalid regex: {}", e.what());
+        return false;
+    }
+}
+
+bool PatternBundleReader::loadFresh(const std::string& config_path, const std::string& source,
+                                    PatternMatcher& matcher) {
+    std::string bundle_path = PatternBundle::defaultPath(config_path);
+    PatternBundleReader reader;
+    if (!reader.open(bundle_path)) {
+        return false;
+    }
+    if (!reader.isFreshFor(source)) {
+        LOG_WARN_FMT("Pattern bundle {} is stale ({} changed), loading patterns from JSON "
+                     "(run --compile-patterns to refresh it)", bundle_path, config_path);
+        return false;
+    }
+    if (!reader.loadInto(matcher)) {
+        return false;
+    }
+
+    LOG_INFO_FMT("Loaded {} precompiled patterns from {}", reader.size(), bundle_path);
+    return true;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include "core/pattern_matcher.h"
+
+/**
+ * Формат бандла паттернов (.bundle), версия 1. Все числа little-endian.
+ *
+ *   [PatternBundle::Header]
+ *   [смещения строк: uint64 x (string_count + 1)]
+ *   [данные строк: UTF-8 без разделителей]
+ *   [записи паттернов: PatternBundle::Record x pattern_count]
+ *   [якоря: uint32 индекс строки x anchor_count]
+ *
+ * Бандл - результат загрузки patterns.json, который уже прошел разбор JSON,
+ * проверку стоимости regex и вывод якорей префильтра. В заголовке хранится
+ * XXH64 и размер исходного JSON: если файл изменился, бандл считается
+ * устаревшим и паттерны загружаются из JSON как обычно.
+ */
+namespace PatternBundle {
+    constexpr char MAGIC[8] = {'S', 'D', 'P', 'A', 'T', 'T', 'R', 'N'};
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr uint32_t NO_STRING = 0xFFFFFFFF;   ///< Паттерн без regex (только энтропия)
+
+    /**
+     * Флаги паттерна
+     */
+    enum Flags : uint32_t {
+        FLAG_USE_ENTROPY = 1u << 0,
+        FLAG_DISABLED = 1u << 1
+    };
+
+    /**
+     * Заголовок файла
+     */
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t source_hash;           ///< XXH64 исходного patterns.json
+        uint64_t source_size;           ///< Размер исходного patterns.json
+        uint64_t pattern_count;
+        uint64_t string_count;
+        uint64_t anchor_count;
+        uint64_t string_offsets_offset;
+        uint64_t string_data_offset;
+        uint64_t records_offset;
+        uint64_t anchors_offset;
+        uint64_t reserved[3];
+    };
+
+    /**
+     * Один паттерн (строки - индексы в таблице строк)
+     */
+    struct Record {
+        uint32_t name;
+        uint32_t regex;                 ///< Исходный текст regex или NO_STRING
+        uint32_t severity;
+        uint32_t description;
+        uint32_t regex_flags;           ///< std::regex::flag_type
+        uint32_t flags;                 ///< PatternBundle::Flags
+        uint32_t first_anchor;          ///< Индекс в секции якорей
+        uint32_t anchor_count;
+        double entropy_threshold;
+    };
+
+    static_assert(sizeof(Header) % 8 == 0, "header must keep 8-byte alignment");
+    static_assert(sizeof(Record) % 8 == 0, "record must keep 8-byte alignment");
+
+    /**
+     * Путь бандла рядом с конфигом: patterns.json -> patterns.json.bundle
+     */
+    inline std::string defaultPath(const std::string& config_path) {
+        return config_path + ".bundle";
+    }
+}
+
+/**
+ * @class PatternBundleWriter
+ * @brief Компиляция patterns.json в бандл
+ */
+class PatternBundleWriter {
+public:
+    /**
+     * Загрузить конфиг (с проверкой стоимости regex) и записать бандл
+     * Файл заменяется атомарно - работающие процессы дочитывают старый.
+     * @param config_path Исходный patterns.json
+     * @param bundle_path Куда записать бандл
+     * @param budget Бюджет стоимости regex при загрузке
+     * @return true если бандл записан
+     */
+    static bool compile(const std::string& config_path, const std::string& bundle_path,
+                        const RegexCostBudget& budget = RegexCostBudget());
+
+    /**
+     * Записать загруженные паттерны
+     * @param matcher Загруженные паттерны
+     * @param source Содержимое исходного JSON (для контрольной суммы)
+     * @param bundle_path Куда записать бандл
+     */
+    static bool write(const PatternMatcher& matcher, const std::string& source,
+                      const std::string& bundle_path);
+};
+
+/**
+ * @class PatternBundleReader
+ * @brief Загрузка бандла через mmap
+ *
+ * Regex компилируются из исходного текста (std::regex не сериализуется),
+ * все остальное - JSON, проверка стоимости, якоря - берется готовым.
+ */
+class PatternBundleReader {
+public:
+    PatternBundleReader() = default;
+    ~PatternBundleReader();
+
+    PatternBundleReader(const PatternBundleReader&) = delete;
+    PatternBundleReader& operator=(const PatternBundleReader&) = delete;
+
+    /**
+     * Открыть бандл
+     * @return true если файл открыт и заголовок корректен
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Закрыть файл (снять mmap)
+     */
+    void close();
+
+    /**
+     * Собран ли бандл из этого содержимого JSON
+     */
+    bool isFreshFor(const std::string& source) const;
+
+    /**
+     * Количество паттернов в бандле
+     */
+    size_t size() const { return header ? header->pattern_count : 0; }
+
+    /**
+     * Заменить паттерны матчера паттернами бандла
+     * @return false если бандл пуст или regex не компилируется
+     */
+    bool loadInto(PatternMatcher& matcher) const;
+
+    /**
+     * Загрузить бандл конфига, если он есть и не устарел
+     * @param config_path patterns.json (бандл ищется по PatternBundle::defaultPath)
+     * @param source Содержимое patterns.json
+     * @return true если паттерны загружены из бандла
+     */
+    static bool loadFresh(const std::string& config_path, const std::string& source,
+                          PatternMatcher& matcher);
+
+private:
+    const unsigned char* data = nullptr;
+    size_t data_size = 0;
+    const PatternBundle::Header* header = nullptr;
+    const uint64_t* string_offsets = nullptr;
+    const char* string_data = nullptr;
+    const PatternBundle::Record* records = nullptr;
+    const uint32_t* anchors = nullptr;
+
+    std::string getString(uint32_t id) const;
+    bool validate() const;
+};
@@ -1,8 +1,16 @@
 #include "core/pattern_matcher.h"
 #include "core/entropy_analyzer.h"
+#include "core/regex_prefilter.h"
+#include "core/builtin_patterns.h"
 #include "utils/logger.h"
+#include "utils/trace_recorder.h"
 #include <fstream>
 #include <sstream>
+#include <chrono>
+#include <algorithm>
+
+// ветка профилирования почти никогда не выполняется
+#define PROFILE_UNLIKELY(x) __builtin_expect(!!(x), 0)
 
 bool PatternMatcher::loadPatterns(const std::string& config_path) {
     try {
@@ -50,6 +58,13 @@ bool PatternMatcher::loadFromJson(const json& patterns_json) {
 
                     // скомпилировать с флагом icase (case-insensitive по умолчанию)
                     pattern.regex = std::regex(regex_str, std::regex::icase | std::regex::ECMAScript);
+                    pattern.regex_source = regex_str;
+                    pattern.anchors = RegexPrefilter::extractAnchors(regex_str, true);
+
+                    // дорогой regex может остановить рабочий поток на одном файле
+                    if (cost_budget.enabled && !checkCost(pattern, pattern_data.value("allow_slow", false))) {
+                        continue;
+                    }
                 }
 
                 // загрузить настройки энтропии если есть
@@ -68,6 +83,9 @@ bool PatternMatcher::loadFromJson(const json& patterns_json) {
         }
 
         LOG_INFO_FMT("Successfully loaded {} patterns", patterns.size());
+        if (counters) {
+            enableProfiling(true);
+        }
         return !patterns.empty();
     } catch (const std::exception& e) {
         LOG_ERROR_FMT("Error loading patterns from JSON: {}", e.what());
@@ -75,51 +93,364 @@ bool PatternMatcher::loadFromJson(const json& patterns_json) {
     }
 }
 
+bool PatternMatcher::loadBuiltin() {
+    try {
+        patterns.clear();
+        patterns.reserve(std::size(BuiltinPatterns::TABLE));
+
+        for (const auto& builtin : BuiltinPatterns::TABLE) {
+            Pattern pattern;
+            pattern.name = std::string(builtin.name);
+            pattern.severity = std::string(severityName(builtin.severity));
+            pattern.description = std::string(builtin.description);
+            pattern.use_entropy = builtin.use_entropy;
+            pattern.entropy_threshold = builtin.entropy_threshold;
+            if (!builtin.regex.empty()) {
+                pattern.regex_source = std::string(builtin.regex);
+                pattern.regex = std::regex(pattern.regex_source, std::regex::icase | std::regex::ECMAScript);
+                pattern.anchors.assign(builtin.anchors, builtin.anchors + builtin.anchor_count);
+            }
+            patterns.push_back(std::move(pattern));
+        }
+
+        LOG_DEBUG_FMT("Loaded {} built-in patterns", patterns.size());
+        if (counters) {
+            enableProfiling(true);
+        }
+        return true;
+    } catch (const std::regex_error& e) {
+        LOG_ERROR_FMT("Invalid built-in regex: {}", e.what());
+        return false;
+    }
+}
+
+bool PatternMatcher::checkCost(const Pattern& pattern, bool allow_slow) const {
+    RegexCost cost = RegexCostAnalyzer::analyze(pattern.regex_source, pattern.regex,
+                                                pattern.anchors, cost_budget);
+    LOG_DEBUG_FMT("Pattern {}: worst probe '{}' at {:.0f} ns/byte", pattern.name,
+                  cost.worst_probe, cost.worst_ns_per_byte);
+
+    for (const auto& warning : cost.warnings) {
+        LOG_WARN_FMT("Pattern {}: {}", pattern.name, warning);
+    }
+    for (const auto& violation : cost.violations) {
+        LOG_WARN_FMT("Pattern {} exceeds regex cost budget: {}", pattern.name, violation);
+    }
+
+    if (cost.rejected() && !allow_slow) {
+        LOG_WARN_FMT("Pattern {} rejected (set \"allow_slow\": true in the config to load it anyway)",
+                     pattern.name);
+        return false;
+    }
+    return true;
+}
+
+namespace {
+    // окно, если max_line_length не задан, а бюджет времени исчерпан
+    constexpr size_t DEFAULT_WINDOW = 16384;
+    // перекрытие окон, когда в окне нет перевода строки
+    constexpr size_t MAX_WINDOW_OVERLAP = 1024;
+
+    Match makeMatch(const std::string& content, size_t pos, const std::string& text,
+                    const Pattern& pattern, const std::string& file_path) {
+        Match match;
+        match.file_path = file_path;
+        match.pattern_name = pattern.name;
+        match.matched_text = text;
+        match.severity = pattern.severity;
+
+        // найти номер строки
+        match.line_number = 1 + std::count(content.begin(), content.begin() + pos, '\n');
+
+        // получить preview (текущую строку)
+        size_t line_start = content.rfind('\n', pos);
+        if (line_start == std::string::npos) line_start = 0;
+        else line_start++;
+
+        size_t line_end = content.find('\n', pos);
+        if (line_end == std::string::npos) line_end = content.length();
+
+        match.preview = content.substr(line_start, line_end - line_start);
+        match.column_number = pos - line_start + 1;
+        match.entropy = 0.0;
+        return match;
+    }
+
+    size_t longestLine(const std::string& content) {
+        size_t longest = 0;
+        size_t line_start = 0;
+        while (line_start < content.size()) {
+            size_t line_end = content.find('\n', line_start);
+            if (line_end == std::string::npos) line_end = content.size();
+            longest = std::max(longest, line_end - line_start);
+            line_start = line_end + 1;
+        }
+        return longest;
+    }
+
+    /**
+     * Работа regex по одному паттерну (для --profile-patterns)
+     */
+    struct RegexWork {
+        uint64_t runs = 0;      ///< Запуски regex: весь файл или одно окно
+        uint64_t bytes = 0;     ///< Байт, переданных regex
+    };
+
+    void markPartial(MatchOutcome* outcome, PartialCause cause, const std::string& reason) {
+        if (outcome) {
+            outcome->partial = true;
+            outcome->cause = cause;
+            outcome->reason = reason;
+        }
+    }
+
+    /**
+     * Поиск паттерна окнами начиная с from
+     * Окно режется по последнему переводу строки; строка длиннее окна
+     * режется с перекрытием. Совпадение, начинающееся в зоне следующего
+     * окна, пропускается - его найдет следующее окно.
+     * @param lowered Содержимое в нижнем регистре для якорей (nullptr - якоря не проверяются)
+     * @param work Запуски regex и просмотренные им байты (окна без якоря не считаются)
+     * @return false, если поиск прерван по hard_deadline или отменен
+     */
+    bool scanWindows(const std::string& content, const std::string* lowered, const Pattern& pattern,
+                     size_t from, size_t window, const std::string& file_path,
+                     const std::chrono::steady_clock::time_point* hard_deadline,
+                     const CancellationToken* cancel, std::vector<Match>& matches, RegexWork& work) {
+        const size_t overlap = std::min(MAX_WINDOW_OVERLAP, window / 4);
+        size_t window_start = from;
+
+        while (window_start < content.size()) {
+            size_t window_end = std::min(content.size(), window_start + window);
+            size_t next_start = window_end;
+            if (window_end < content.size()) {
+                size_t newline = content.rfind('\n', window_end - 1);
+                if (newline != std::string::npos && newline >= window_start) {
+                    window_end = newline + 1;
+                    next_start = window_end;
+                } else {
+                    next_start = std::max(window_start + 1, window_end - overlap);
+                }
+            }
+
+            const std::string* anchor_text = pattern.anchors.empty() ? nullptr
+                : (pattern.regex.flags() & std::regex::icase) ? lowered : &content;
+            bool skip = anchor_text != nullptr && !RegexPrefilter::containsAny(
+                std::string_view(*anchor_text).substr(window_start, window_end - window_start),
+                pattern.anchors);
+
+            if (!skip) {
+                auto flags = std::regex_constants::match_default;
+                if (window_start > 0) flags |= std::regex_constants::match_prev_avail;
+                if (window_end < content.size()) flags |= std::regex_constants::match_not_eol;
+                work.runs++;
+                work.bytes += window_end - window_start;
+
+                std::sregex_iterator iter(content.begin() + window_start, content.begin() + window_end,
+                                          pattern.regex, flags);
+                std::sregex_iterator end;
+                for (; iter != end; ++iter) {
+                    size_t pos = window_start + iter->position();
+                    if (window_end < content.size() && pos >= next_start) {
+                        break;
+                    }
+                    matches.push_back(makeMatch(content, pos, iter->str(), pattern, file_path));
+                }
+            }
+
+            if (hard_deadline && std::chrono::steady_clock::now() > *hard_deadline) {
+                return false;
+            }
+            if (cancel && cancel->isCancelled()) {
+                return false;
+            }
+            window_start = next_start;
+        }
+        return true;
+    }
+
+    std::string formatMs(double ms) {
+        return std::to_string(static_cast<long long>(ms)) + " ms";
+    }
+}
+
+std::string partialCauseName(PartialCause cause) {
+    switch (cause) {
+        case PartialCause::LongLines: return "long_lines";
+        case PartialCause::TimeBudget: return "time_budget";
+        case PartialCause::Cancelled: return "cancelled";
+    }
+    return "time_budget";
+}
 
 std::vector<Match> PatternMatcher::findMatches(const std::string& content,
                                                 const std::string& file_path) const {
+    return scanContent(content, file_path, engine, nullptr, nullptr);
+}
+
+std::vector<Match> PatternMatcher::findMatches(const std::string& content,
+                                                const std::string& file_path,
+                                                MatchEngine match_engine) const {
+    return scanContent(content, file_path, match_engine, nullptr, nullptr);
+}
+
+std::vector<Match> PatternMatcher::findMatches(const std::string& content,
+                                                const std::string& file_path,
+                                                const MatchBudget& budget,
+                                                MatchOutcome& outcome) const {
+    outcome = MatchOutcome();
+    return scanContent(content, file_path, engine, &budget, &outcome);
+}
+
+std::vector<Match> PatternMatcher::scanContent(const std::string& content,
+                                                const std::string& file_path,
+                                                MatchEngine match_engine,
+                                                const MatchBudget* budget,
+                                                MatchOutcome* outcome) const {
+    using clock = std::chrono::steady_clock;
     std::vector<Match> matches;
+
+    // содержимое в нижнем регистре для якорей icase паттернов (строится один раз по требованию)
+    std::string lowered;
+    bool lowered_ready = false;
+    auto loweredContent = [&]() -> const std::string& {
+        if (!lowered_ready) {
+            lowered = RegexPrefilter::toLowerAscii(content);
+            lowered_ready = true;
+        }
+        return lowered;
+    };
+
+    // бюджет: после time_ms - окна, после 2 * time_ms - остановка
+    const bool timed = budget != nullptr && budget->time_ms > 0.0;
+    clock::time_point soft_deadline;
+    clock::time_point hard_deadline;
+    if (timed) {
+        auto budget_duration = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double, std::milli>(budget->time_ms));
+        soft_deadline = clock::now() + budget_duration;
+        hard_deadline = soft_deadline + budget_duration;
+    }
+    const size_t window = budget != nullptr && budget->max_line_length > 0 ?
+        budget->max_line_length : DEFAULT_WINDOW;
+    const CancellationToken* cancel = budget != nullptr ? budget->cancel : nullptr;
+
+    // длинное совпадение в std::regex переполняет стек - такие файлы сразу окнами
+    bool windowed = false;
+    if (budget != nullptr && budget->max_line_length > 0 && longestLine(content) > budget->max_line_length) {
+        windowed = true;
+        markPartial(outcome, PartialCause::LongLines,
+                    "line longer than " + std::to_string(budget->max_line_length) +
+                    " bytes scanned in windows");
+    }
     
     // применяем regex паттерны
-    for (const auto& pattern : patterns) {
+    for (size_t index = 0; index < patterns.size(); ++index) {
+        const auto& pattern = patterns[index];
+
         // пропустить паттерны с энтропией (обработаем отдельно)
         if (pattern.use_entropy) {
             continue;
         }
-        
+        TRACE_SCOPE_DETAIL("match", "match", &pattern.name);
+
+        if (cancel && cancel->isCancelled()) {
+            markPartial(outcome, PartialCause::Cancelled, "scan cancelled, findings are incomplete");
+            break;
+        }
+        if (timed) {
+            auto now = clock::now();
+            if (now > hard_deadline) {
+                markPartial(outcome, PartialCause::TimeBudget,
+                            "scan stopped after " + formatMs(2 * budget->time_ms) +
+                            ", findings are incomplete");
+                break;
+            }
+            if (!windowed && now > soft_deadline) {
+                windowed = true;
+                markPartial(outcome, PartialCause::TimeBudget,
+                            "time budget of " + formatMs(budget->time_ms) +
+                            " exceeded, rest scanned in windows");
+            }
+        }
+
+        ProfileCounters* profile = nullptr;
+        size_t matches_before = 0;
+        clock::time_point profile_start;
+        if (PROFILE_UNLIKELY(counters != nullptr) && index < counter_count) {
+            profile = &counters[index];
+            matches_before = matches.size();
+            profile_start = clock::now();
+        }
+
+        // префильтр: без якоря в содержимом regex заведомо ничего не найдет
+        bool skip = false;
+        if (match_engine == MatchEngine::Prefilter && !pattern.anchors.empty()) {
+            const std::string& text = (pattern.regex.flags() & std::regex::icase) ? loweredContent() : content;
+            skip = !RegexPrefilter::containsAny(text, pattern.anchors);
+        }
+
+        bool stopped = false;
+        RegexWork work;
         try {
-            std::sregex_iterator iter(content.begin(), content.end(), pattern.regex);
-            std::sregex_iterator end;
-            
-            while (iter != end) {
-                Match match;
-                match.file_path = file_path;
-                match.pattern_name = pattern.name;
-                match.matched_text = iter->str();
-                match.severity = pattern.severity;
-                
-                // найти номер строки
-                size_t pos = iter->position();
-                match.line_number = 1 + std::count(content.begin(), content.begin() + pos, '\n');
-                
-                // получить preview (текущую строку)
-                size_t line_start = content.rfind('\n', pos);
-                if (line_start == std::string::npos) line_start = 0;
-                else line_start++;
-                
-                size_t line_end = content.find('\n', pos);
-                if (line_end == std::string::npos) line_end = content.length();
-                
-                match.preview = content.substr(line_start, line_end - line_start);
-                match.column_number = pos - line_start + 1;
-                match.entropy = 0.0;
-                
-                matches.push_back(match);
-                ++iter;
+            // позиция, с которой продолжить окнами после исчерпания бюджета
+            size_t resume = 0;
+            if (!skip && !windowed) {
+                work.runs++;
+                work.bytes += content.size();
+                std::sregex_iterator iter(content.begin(), content.end(), pattern.regex);
+                std::sregex_iterator end;
+                for (; iter != end; ++iter) {
+                    size_t pos = iter->position();
+                    matches.push_back(makeMatch(content, pos, iter->str(), pattern, file_path));
+
+                    if (cancel && cancel->isCancelled()) {
+                        stopped = true;
+                        break;
+                    }
+                    if (timed && clock::now() > soft_deadline) {
+                        windowed = true;
+                        resume = pos + std::max<size_t>(1, iter->length());
+                        // остаток файла досчитается по окнам
+                        work.bytes -= content.size() - resume;
+                        markPartial(outcome, PartialCause::TimeBudget,
+                                    "time budget of " + formatMs(budget->time_ms) +
+                                    " exceeded, rest scanned in windows");
+                        break;
+                    }
+                }
+            }
+            if (!skip && windowed && !stopped) {
+                const std::string* anchor_text = pattern.anchors.empty() ? nullptr : &loweredContent();
+                stopped = !scanWindows(content, anchor_text, pattern, resume, window, file_path,
+                                       timed ? &hard_deadline : nullptr, cancel, matches, work);
             }
         } catch (const std::regex_error& e) {
             LOG_WARN_FMT("Invalid regex for pattern {}: {}", pattern.name, e.what());
         }
+
+        if (PROFILE_UNLIKELY(profile != nullptr)) {
+            auto elapsed = clock::now() - profile_start;
+            uint64_t found = matches.size() - matches_before;
+            profile->time_ns.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                std::memory_order_relaxed);
+            // паттерн, отсеянный префильтром, не добавляет ни байт, ни кандидатов
+            profile->bytes_examined.fetch_add(work.bytes, std::memory_order_relaxed);
+            profile->candidates.fetch_add(work.runs, std::memory_order_relaxed);
+            profile->confirmed.fetch_add(found, std::memory_order_relaxed);
+        }
+
+        if (stopped) {
+            if (cancel && cancel->isCancelled()) {
+                markPartial(outcome, PartialCause::Cancelled, "scan cancelled, findings are incomplete");
+            } else {
+                markPartial(outcome, PartialCause::TimeBudget,
+                            "scan stopped after " + formatMs(2 * budget->time_ms) +
+                            ", findings are incomplete");
+            }
+            break;
+        }
     }
     
     // отключить энтропию, пока что
@@ -142,6 +473,55 @@ std::vector<Match> PatternMatcher::findMatches(const std::string& content,
 
 void PatternMatcher::addPattern(const Pattern& pattern) {
     patterns.push_back(pattern);
+    Pattern& added = patterns.back();
+    if (added.anchors.empty() && !added.regex_source.empty()) {
+        added.anchors = RegexPrefilter::extractAnchors(
+            added.regex_source, (added.regex.flags() & std::regex::icase) != 0);
+    }
+    if (counters) {
+        enableProfiling(true);
+    }
+}
+
+void PatternMatcher::enableProfiling(bool enable) {
+    if (!enable) {
+        counters.reset();
+        counter_count = 0;
+        return;
+    }
+    counters = std::make_unique<ProfileCounters[]>(patterns.size());
+    counter_count = patterns.size();
+}
+
+void PatternMatcher::resetProfile() {
+    for (size_t i = 0; i < counter_count; ++i) {
+        counters[i].time_ns.store(0, std::memory_order_relaxed);
+        counters[i].bytes_examined.store(0, std::memory_order_relaxed);
+        counters[i].candidates.store(0, std::memory_order_relaxed);
+        counters[i].confirmed.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<PatternProfile> PatternMatcher::getProfile() const {
+    std::vector<PatternProfile> profile;
+    for (size_t i = 0; i < counter_count && i < patterns.size(); ++i) {
+        if (patterns[i].use_entropy) {
+            continue;
+        }
+        PatternProfile entry;
+        entry.name = patterns[i].name;
+        entry.time_ns = counters[i].time_ns.load(std::memory_order_relaxed);
+        entry.bytes_examined = counters[i].bytes_examined.load(std::memory_order_relaxed);
+        entry.candidates = counters[i].candidates.load(std::memory_order_relaxed);
+        entry.confirmed = counters[i].confirmed.load(std::memory_order_relaxed);
+        profile.push_back(entry);
+    }
+
+    std::sort(profile.begin(), profile.end(), [](const PatternProfile& a, const PatternProfile& b) {
+        if (a.time_ns != b.time_ns) return a.time_ns > b.time_ns;
+        return a.name < b.name;
+    });
+    return profile;
 }
 
 #include "core/entropy_analyzer.h"
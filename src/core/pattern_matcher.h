@@ -3,7 +3,12 @@
 #include <string>
 #include <vector>
 #include <regex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 #include <nlohmann/json.hpp>
+#include "regex_cost.h"
+#include "cancellation.h"
 
 using json = nlohmann::json;
 
@@ -19,6 +24,17 @@ struct Pattern {
     bool use_entropy = false;   ///< Использовать энтропию анализ
     double entropy_threshold = 4.0; ///< Порог энтропии
     bool enabled = true;
+    std::string regex_source;   ///< Исходный текст regex
+    std::vector<std::string> anchors;   ///< Литералы, один из которых есть в любом совпадении (пусто - нет префильтра)
+};
+
+/**
+ * @enum MatchEngine
+ * @brief Движок поиска совпадений
+ */
+enum class MatchEngine {
+    Regex,      ///< std::regex по всему содержимому (эталон)
+    Prefilter   ///< std::regex только если в содержимом есть якоря паттерна
 };
 
 /**
@@ -34,6 +50,7 @@ struct Match {
     std::string severity;       ///< Уровень серьёзности
     std::string preview;        ///< Контекст (предпросмотр строки)
     double entropy;             ///< Рассчитанная энтропия (если использовалась)
+    std::string commit;         ///< Коммит, где находка появилась впервые (сканирование истории git)
     
     /**
      * Конвертировать Match в JSON
@@ -50,6 +67,74 @@ struct Match {
         if (entropy > 0) {
             j["entropy"] = entropy;
         }
+        if (!commit.empty()) {
+            j["commit"] = commit;
+        }
+        return j;
+    }
+};
+
+/**
+ * @struct MatchBudget
+ * @brief Ограничения поиска в одном файле
+ *
+ * Файл, превысивший бюджет, досканируется в дешевом режиме: окнами
+ * ограниченной длины (с разрезом по переводам строк) и только там, где
+ * есть якоря паттерна. Совпадения, пересекающие границу окна, могут
+ * потеряться, поэтому такой файл помечается как просканированный частично.
+ */
+struct MatchBudget {
+    double time_ms = 0.0;           ///< Время на файл, после него - окна (0 - без ограничения)
+    size_t max_line_length = 0;     ///< Строки длиннее сразу сканируются окнами (0 - без ограничения)
+    const CancellationToken* cancel = nullptr;  ///< Отмена: проверяется там же, где время (nullptr - нет)
+};
+
+/**
+ * @enum PartialCause
+ * @brief Почему файл просканирован не полностью
+ */
+enum class PartialCause {
+    LongLines,      ///< Строка длиннее --max-line-length, поиск по окнам (время не превышено)
+    TimeBudget,     ///< Превышен бюджет времени на файл
+    Cancelled       ///< Сканирование прервано
+};
+
+/**
+ * Имя причины для отчетов и метрик: long_lines, time_budget, cancelled
+ */
+std::string partialCauseName(PartialCause cause);
+
+/**
+ * @struct MatchOutcome
+ * @brief Итог поиска с бюджетом
+ */
+struct MatchOutcome {
+    bool partial = false;   ///< Файл просканирован не полностью
+    PartialCause cause = PartialCause::TimeBudget;  ///< Последняя причина (перекрывает предыдущие)
+    std::string reason;     ///< Причина (для отчета)
+};
+
+/**
+ * @struct PatternProfile
+ * @brief Профиль одного паттерна (режим --profile-patterns)
+ */
+struct PatternProfile {
+    std::string name;               ///< Имя паттерна
+    uint64_t time_ns = 0;           ///< Суммарное время поиска (по всем потокам)
+    uint64_t bytes_examined = 0;    ///< Байт, просмотренных regex (отсеянное префильтром не считается)
+    uint64_t candidates = 0;        ///< Запуски regex по файлу или окну, пропущенные префильтром
+    uint64_t confirmed = 0;         ///< Находки
+
+    /**
+     * Конвертировать профиль в JSON
+     */
+    json to_json() const {
+        json j;
+        j["pattern"] = name;
+        j["time_ms"] = time_ns / 1e6;
+        j["bytes_examined"] = bytes_examined;
+        j["candidates"] = candidates;
+        j["confirmed"] = confirmed;
         return j;
     }
 };
@@ -75,6 +160,12 @@ public:
      */
     bool loadFromJson(const json& patterns_json);
 
+    /**
+     * Загрузить встроенные паттерны из таблицы BuiltinPatterns::TABLE
+     * Без JSON и проверки стоимости: якоря уже вычислены, стоимость проверяют тесты.
+     */
+    bool loadBuiltin();
+
     /**
      * Найти все совпадения в тексте
      * @param content Содержимое файла
@@ -83,12 +174,55 @@ public:
      */
     std::vector<Match> findMatches(const std::string& content, 
                                    const std::string& file_path) const;
+
+    /**
+     * Найти все совпадения заданным движком (для сравнения движков)
+     */
+    std::vector<Match> findMatches(const std::string& content,
+                                   const std::string& file_path,
+                                   MatchEngine match_engine) const;
+
+    /**
+     * Найти все совпадения с бюджетом на файл
+     * std::regex нельзя прервать посреди поиска, поэтому время проверяется
+     * между паттернами и между совпадениями; от длинных совпадений (и
+     * переполнения стека в std::regex) защищает max_line_length.
+     * После отмены (budget.cancel) поиск останавливается в тех же точках.
+     * @param budget Бюджет
+     * @param outcome Был ли файл просканирован частично и почему
+     */
+    std::vector<Match> findMatches(const std::string& content,
+                                   const std::string& file_path,
+                                   const MatchBudget& budget,
+                                   MatchOutcome& outcome) const;
+
+    /**
+     * Установить бюджет стоимости regex для следующих загрузок
+     * Паттерн, превысивший бюджет на пробах, не загружается
+     * (кроме паттернов с "allow_slow": true в конфиге).
+     */
+    void setCostBudget(const RegexCostBudget& budget) { cost_budget = budget; }
+
+    /**
+     * Выбрать движок поиска (по умолчанию MatchEngine::Regex)
+     */
+    void setEngine(MatchEngine match_engine) { engine = match_engine; }
+
+    /**
+     * Текущий движок поиска
+     */
+    MatchEngine getEngine() const { return engine; }
     
     /**
      * Добавить кастомный паттерн
      */
     void addPattern(const Pattern& pattern);
 
+    /**
+     * Удалить все паттерны
+     */
+    void clearPatterns() { patterns.clear(); }
+
     /**
      * Получить количество загруженных паттернов
      */
@@ -99,6 +233,55 @@ public:
      */
     const std::vector<Pattern>& getPatterns() const { return patterns; }
 
+    /**
+     * Включить/выключить профилирование паттернов
+     * Выключенное профилирование стоит одной предсказуемой проверки указателя
+     * на вызов findMatches. Включение обнуляет накопленные счетчики.
+     */
+    void enableProfiling(bool enable);
+
+    /**
+     * Профилирование включено
+     */
+    bool isProfiling() const { return counters != nullptr; }
+
+    /**
+     * Обнулить счетчики профиля
+     */
+    void resetProfile();
+
+    /**
+     * Получить профиль паттернов, отсортированный по времени (сначала самые медленные)
+     */
+    std::vector<PatternProfile> getProfile() const;
+
 private:
+    /**
+     * Проверить стоимость regex паттерна (предупреждения и причины - в лог)
+     * @return false если паттерн превысил бюджет и должен быть отклонен
+     */
+    bool checkCost(const Pattern& pattern, bool allow_slow) const;
+
+    /**
+     * Поиск выбранным движком; budget == nullptr - без ограничений
+     */
+    std::vector<Match> scanContent(const std::string& content,
+                                   const std::string& file_path,
+                                   MatchEngine match_engine,
+                                   const MatchBudget* budget,
+                                   MatchOutcome* outcome) const;
+
+    // счетчики на отдельных cache line - рабочие потоки пишут их одновременно
+    struct alignas(64) ProfileCounters {
+        std::atomic<uint64_t> time_ns{0};
+        std::atomic<uint64_t> bytes_examined{0};
+        std::atomic<uint64_t> candidates{0};
+        std::atomic<uint64_t> confirmed{0};
+    };
+
     std::vector<Pattern> patterns;
+    MatchEngine engine = MatchEngine::Regex;
+    RegexCostBudget cost_budget;
+    std::unique_ptr<ProfileCounters[]> counters;   ///< nullptr - профилирование выключено
+    size_t counter_count = 0;
 };
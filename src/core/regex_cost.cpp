@@ -0,0 +1,497 @@
+#include "core/regex_cost.h"
+#include <bitset>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace {
+    constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+    /**
+     * Форма подвыражения - ровно то, что нужно для поиска опасных конструкций
+     */
+    struct Shape {
+        std::bitset<256> first;         ///< Возможные первые символы
+        bool first_any = false;         ///< Первым может быть почти любой символ (класс, '.')
+        bool nullable = true;           ///< Может совпасть с пустой строкой
+        bool zero_width = true;         ///< Не потребляет символов (^, $, \b, lookahead)
+        bool start_anchor = false;      ///< Начинается с '^'
+        bool unbounded = false;         ///< Содержит неограниченный квантификатор
+        bool ambiguous = false;         ///< Альтернатива с пересекающимися ветками
+        bool leading_wildcard = false;  ///< Начинается с неограниченного повтора класса
+    };
+
+    bool overlaps(const Shape& a, const Shape& b) {
+        // пустая ветка под повтором тоже дает несколько путей разбора
+        if (a.nullable || b.nullable) return true;
+        if (a.first_any || b.first_any) return true;
+        return (a.first & b.first).any();
+    }
+
+    std::string excerpt(const std::string& text) {
+        const size_t max_length = 40;
+        return text.size() <= max_length ? text : text.substr(0, max_length) + "...";
+    }
+
+    class ShapeParser {
+    public:
+        explicit ShapeParser(const std::string& regex) : src(regex) {}
+
+        bool parse(Shape& out) {
+            out = alternation();
+            return !failed && pos == src.size();
+        }
+
+        std::vector<std::string> issues;
+
+    private:
+        const std::string& src;
+        size_t pos = 0;
+        bool failed = false;
+
+        bool atEnd() const { return pos >= src.size(); }
+
+        void addIssue(const std::string& issue) {
+            if (std::find(issues.begin(), issues.end(), issue) == issues.end()) {
+                issues.push_back(issue);
+            }
+        }
+
+        static Shape literal(unsigned char c) {
+            Shape shape;
+            shape.first.set(c);
+            shape.first.set(static_cast<unsigned char>(std::tolower(c)));
+            shape.first.set(static_cast<unsigned char>(std::toupper(c)));
+            shape.nullable = false;
+            shape.zero_width = false;
+            return shape;
+        }
+
+        static Shape anyChar() {
+            Shape shape;
+            shape.first_any = true;
+            shape.nullable = false;
+            shape.zero_width = false;
+            return shape;
+        }
+
+        Shape alternation() {
+            std::vector<Shape> branches{concatenation()};
+            while (!failed && !atEnd() && src[pos] == '|') {
+                ++pos;
+                branches.push_back(concatenation());
+            }
+            if (branches.size() == 1) {
+                return branches.front();
+            }
+
+            Shape result;
+            result.nullable = false;
+            for (size_t i = 0; i < branches.size(); ++i) {
+                const Shape& branch = branches[i];
+                result.first |= branch.first;
+                result.first_any = result.first_any || branch.first_any;
+                result.nullable = result.nullable || branch.nullable;
+                result.zero_width = result.zero_width && branch.zero_width;
+                result.unbounded = result.unbounded || branch.unbounded;
+                result.leading_wildcard = result.leading_wildcard || branch.leading_wildcard;
+                for (size_t j = 0; j < i; ++j) {
+                    result.ambiguous = result.ambiguous || overlaps(branch, branches[j]);
+                }
+            }
+            return result;
+        }
+
+        Shape concatenation() {
+            Shape result;
+            bool first_item = true;
+            while (!failed && !atEnd() && src[pos] != '|' && src[pos] != ')') {
+                Shape item = repetition();
+                if (result.nullable) {
+                    result.first |= item.first;
+                    result.first_any = result.first_any || item.first_any;
+                }
+                if (first_item && !item.zero_width) {
+                    result.leading_wildcard = item.leading_wildcard;
+                    first_item = false;
+                } else if (first_item && item.start_anchor) {
+                    // ^ в начале: повтор проверяется с одной позиции
+                    result.start_anchor = true;
+                    first_item = false;
+                }
+                result.nullable = result.nullable && item.nullable;
+                result.zero_width = result.zero_width && item.zero_width;
+                result.unbounded = result.unbounded || item.unbounded;
+            }
+            return result;
+        }
+
+        bool number(size_t& out) {
+            size_t start = pos;
+            out = 0;
+            while (!atEnd() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+                out = std::min<size_t>(out * 10 + (src[pos] - '0'), 1u << 20);
+                ++pos;
+            }
+            return pos > start;
+        }
+
+        Shape repetition() {
+            size_t start = pos;
+            Shape item = atom();
+            while (!failed && !atEnd()) {
+                size_t min_count = 0;
+                size_t max_count = UNBOUNDED;
+                char c = src[pos];
+                if (c == '*') {
+                    ++pos;
+                } else if (c == '+') {
+                    ++pos;
+                    min_count = 1;
+                } else if (c == '?') {
+                    ++pos;
+                    max_count = 1;
+                } else if (c == '{') {
+                    ++pos;
+                    if (!number(min_count)) {
+                        failed = true;
+                        return item;
+                    }
+                    max_count = min_count;
+                    if (!atEnd() && src[pos] == ',') {
+                        ++pos;
+                        if (!number(max_count)) max_count = UNBOUNDED;
+                    }
+                    if (atEnd() || src[pos] != '}') {
+                        failed = true;
+                        return item;
+                    }
+                    ++pos;
+                } else {
+                    break;
+                }
+                if (!atEnd() && src[pos] == '?') {
+                    ++pos;
+                }
+
+                std::string text = excerpt(src.substr(start, pos - start));
+                if (max_count > 1 && item.unbounded) {
+                    addIssue("nested quantifier `" + text + "` (exponential backtracking)");
+                }
+                if (max_count == UNBOUNDED && item.ambiguous) {
+                    addIssue("ambiguous alternation under repetition `" + text +
+                             "` (branches can match the same text)");
+                }
+
+                item.leading_wildcard = item.leading_wildcard ||
+                                        (max_count == UNBOUNDED && item.first_any);
+                item.unbounded = item.unbounded || max_count == UNBOUNDED;
+                item.nullable = item.nullable || min_count == 0;
+                item.ambiguous = false;
+            }
+            return item;
+        }
+
+        Shape atom() {
+            char c = src[pos++];
+            switch (c) {
+                case '(': return group();
+                case '[': return charClass();
+                case '.': return anyChar();
+                case '^': {
+                    Shape shape;
+                    shape.start_anchor = true;
+                    return shape;
+                }
+                case '$': return Shape();
+                case '\\': return escape();
+                default: return literal(static_cast<unsigned char>(c));
+            }
+        }
+
+        Shape group() {
+            bool lookahead = false;
+            if (src.compare(pos, 2, "?:") == 0) {
+                pos += 2;
+            } else if (src.compare(pos, 2, "?=") == 0 || src.compare(pos, 2, "?!") == 0) {
+                pos += 2;
+                lookahead = true;
+            }
+            Shape inner = alternation();
+            if (failed || atEnd() || src[pos] != ')') {
+                failed = true;
+                return inner;
+            }
+            ++pos;
+            return lookahead ? Shape() : inner;
+        }
+
+        Shape charClass() {
+            if (!atEnd() && src[pos] == '^') ++pos;
+            while (!atEnd() && src[pos] != ']') {
+                if (src[pos] == '\\') ++pos;
+                ++pos;
+            }
+            if (atEnd()) {
+                failed = true;
+                return anyChar();
+            }
+            ++pos;
+            return anyChar();
+        }
+
+        Shape escape() {
+            if (atEnd()) {
+                failed = true;
+                return Shape();
+            }
+            char c = src[pos++];
+            switch (c) {
+                case 'b': case 'B': return Shape();
+                case 'd': case 'D': case 'w': case 'W': case 's': case 'S': return anyChar();
+                case 'n': return literal('\n');
+                case 't': return literal('\t');
+                case 'r': return literal('\r');
+                case 'x': pos = std::min(src.size(), pos + 2); return anyChar();
+                case 'u': pos = std::min(src.size(), pos + 4); return anyChar();
+                default:
+                    if (c >= '1' && c <= '9') {
+                        // обратная ссылка: текст неизвестен, может быть пустым
+                        Shape shape = anyChar();
+                        shape.nullable = true;
+                        return shape;
+                    }
+                    return literal(static_cast<unsigned char>(c));
+            }
+        }
+    };
+
+    struct ProbeFamily {
+        std::string name;
+        std::string unit;   ///< Повторяемый фрагмент
+        std::string tail;   ///< Окончание, на котором совпадение срывается
+    };
+
+    std::vector<ProbeFamily> probeFamilies(const std::string& source,
+                                           const std::vector<std::string>& anchors) {
+        std::vector<ProbeFamily> families = {
+            {"repeated 'a'", "a", "!"},
+            {"alphanumeric line", "aZ3x9Qk_", "!"},
+            {"whitespace", " \t", "!"},
+        };
+
+        // литералы самого regex: на них срабатывают его альтернативы и повторы
+        std::string literals;
+        for (char c : source) {
+            if (std::isalnum(static_cast<unsigned char>(c)) || std::string("_-:=/@.").find(c) != std::string::npos) {
+                if (literals.empty() || literals.back() != c) {
+                    literals += c;
+                }
+            }
+        }
+        if (!literals.empty()) {
+            families.push_back({"pattern literals", literals, "!"});
+        }
+
+        // повторяющийся якорь: каждая позиция начинает частичное совпадение
+        const size_t max_anchor_probes = 3;
+        for (size_t i = 0; i < anchors.size() && i < max_anchor_probes; ++i) {
+            families.push_back({"repeated '" + anchors[i] + "'", anchors[i] + " ", "!"});
+        }
+        return families;
+    }
+
+    /**
+     * Длины проб: мелкие шаги до 32 байт (экспоненциальный рост ловится
+     * раньше, чем время станет заметным), затем удвоение - квадратичный
+     * regex превышает бюджет не больше чем в 4 раза
+     */
+    std::vector<size_t> probeSizes(size_t max_bytes) {
+        std::vector<size_t> sizes;
+        for (size_t size = 2; size <= 32 && size <= max_bytes; size += 2) {
+            sizes.push_back(size);
+        }
+        for (size_t size = 64; size < max_bytes; size *= 2) {
+            sizes.push_back(size);
+        }
+        if (max_bytes > 32) {
+            sizes.push_back(max_bytes);
+        }
+        return sizes;
+    }
+
+    std::string buildProbe(const ProbeFamily& family, size_t size) {
+        std::string input;
+        input.reserve(size + family.tail.size());
+        while (input.size() < size) {
+            input += family.unit;
+        }
+        input.resize(size);
+        return input + family.tail;
+    }
+
+    /// Замеры короче этого сравниваются как равные ему
+    constexpr double NOISE_FLOOR_MS = 0.05;
+
+    /**
+     * Рост больше чем n^4 на двух соседних шагах подряд не дает ни один
+     * полиномиальный regex, а у экспоненциального степень растет с длиной
+     */
+    constexpr double MAX_GROWTH_DEGREE = 4.0;
+
+    /// Рост быстрее n^1.5 на замере не короче 1 мс - семейство проб останавливается
+    constexpr double SUPERLINEAR_DEGREE = 1.5;
+    constexpr double SUPERLINEAR_MIN_MS = 1.0;
+
+    double runProbe(const std::regex& regex, const std::string& input) {
+        auto start = std::chrono::steady_clock::now();
+        // как в PatternMatcher::findMatches - перебор всех совпадений
+        std::sregex_iterator iter(input.begin(), input.end(), regex);
+        std::sregex_iterator end;
+        while (iter != end) {
+            ++iter;
+        }
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    /// Степень k в t ~ n^k между двумя замерами
+    double growthDegree(size_t size_a, double ms_a, size_t size_b, double ms_b) {
+        return std::log(ms_b / ms_a) /
+               std::log(static_cast<double>(size_b) / static_cast<double>(size_a));
+    }
+}
+
+std::vector<std::string> RegexCostAnalyzer::structuralIssues(const std::string& source) {
+    ShapeParser parser(source);
+    Shape shape;
+    if (!parser.parse(shape)) {
+        return parser.issues;
+    }
+    if (shape.leading_wildcard && !shape.start_anchor) {
+        parser.issues.push_back("leading unbounded quantifier (each start position rescans the rest of the line)");
+    }
+    return parser.issues;
+}
+
+void RegexCostAnalyzer::probe(const std::regex& regex, const std::string& source,
+                              const std::vector<std::string>& anchors,
+                              const RegexCostBudget& budget, RegexCost& cost) {
+    std::vector<size_t> sizes = probeSizes(budget.max_probe_bytes);
+    const size_t repeats = std::max<size_t>(1, budget.probe_repeats);
+    double total_ms = 0.0;
+
+    for (const auto& family : probeFamilies(source, anchors)) {
+        double previous_ms = 0.0;
+        size_t previous_size = 0;
+        int steep_steps = 0;
+        for (size_t size : sizes) {
+            std::string input = buildProbe(family, size);
+
+            // минимум из нескольких повторов: вытеснение потока и соседние
+            // процессы только увеличивают время, поэтому минимум устойчив к нагрузке;
+            // замер сверх бюджета не повторяется - медленнее он уже не станет
+            double elapsed_ms = 0.0;
+            try {
+                elapsed_ms = std::numeric_limits<double>::max();
+                for (size_t i = 0; i < repeats; ++i) {
+                    double run_ms = runProbe(regex, input);
+                    total_ms += run_ms;
+                    elapsed_ms = std::min(elapsed_ms, run_ms);
+                    if (run_ms > budget.probe_budget_ms) {
+                        break;
+                    }
+                }
+            } catch (const std::regex_error& e) {
+                cost.violations.push_back("backtracking limit exceeded on " + family.name +
+                                          " probe of " + std::to_string(size) + " bytes (" +
+                                          e.what() + ")");
+                return;
+            }
+
+            // рост времени между соседними длинами; слишком короткие замеры
+            // не сравниваются - в них больше шума, чем работы regex
+            double degree = 0.0;
+            if (previous_size > 0 && elapsed_ms >= NOISE_FLOOR_MS) {
+                degree = growthDegree(previous_size, std::max(previous_ms, NOISE_FLOOR_MS),
+                                      size, elapsed_ms);
+            }
+            steep_steps = degree > MAX_GROWTH_DEGREE ? steep_steps + 1 : 0;
+            bool over_budget = elapsed_ms > budget.probe_budget_ms;
+
+            // экспоненциальный рост: отклоняется не дожидаясь бюджета
+            if (steep_steps >= 2 || (over_budget && steep_steps > 0)) {
+                char buf[200];
+                std::snprintf(buf, sizeof(buf),
+                              "time grows exponentially with length on %s probe "
+                              "(%.2f ms at %zu bytes, %.2f ms at %zu bytes)",
+                              family.name.c_str(), previous_ms, previous_size, elapsed_ms, size);
+                cost.violations.push_back(buf);
+                return;
+            }
+
+            // стоимость байта - только на длинных пробах, на коротких больше шума
+            if (size > 32 || size == sizes.back()) {
+                double ns_per_byte = elapsed_ms * 1e6 / static_cast<double>(size);
+                if (ns_per_byte > cost.worst_ns_per_byte) {
+                    cost.worst_ns_per_byte = ns_per_byte;
+                    cost.worst_probe = family.name;
+                }
+            }
+
+            if (over_budget) {
+                // медленно, но без признаков экспоненты: дальше пробы только дольше
+                char buf[200];
+                std::snprintf(buf, sizeof(buf), "%s probe of %zu bytes took %.1f ms (budget %.1f ms)",
+                              family.name.c_str(), size, elapsed_ms, budget.probe_budget_ms);
+                cost.warnings.push_back(buf);
+                break;
+            }
+
+            // полиномиальный рост (.*secret - квадрат): ответ уже известен,
+            // следующие удвоения стоили бы в 4 раза дороже каждое
+            if (steep_steps == 0 && degree > SUPERLINEAR_DEGREE && elapsed_ms >= SUPERLINEAR_MIN_MS) {
+                char buf[200];
+                std::snprintf(buf, sizeof(buf),
+                              "time grows superlinearly with line length on %s probe "
+                              "(%.2f ms at %zu bytes, %.2f ms at %zu bytes)",
+                              family.name.c_str(), previous_ms, previous_size, elapsed_ms, size);
+                cost.warnings.push_back(buf);
+                break;
+            }
+
+            if (total_ms > budget.total_budget_ms) {
+                break;
+            }
+            previous_ms = elapsed_ms;
+            previous_size = size;
+        }
+
+        if (total_ms > budget.total_budget_ms) {
+            char buf[160];
+            std::snprintf(buf, sizeof(buf), "probing stopped after %.0f ms (total budget %.0f ms)",
+                          total_ms, budget.total_budget_ms);
+            cost.warnings.push_back(buf);
+            break;
+        }
+    }
+
+    if (cost.worst_ns_per_byte > budget.slow_ns_per_byte) {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "slow on %s probe: %.0f ns/byte (about %.0f KB/s)",
+                      cost.worst_probe.c_str(), cost.worst_ns_per_byte,
+                      1e9 / cost.worst_ns_per_byte / 1024.0);
+        cost.warnings.push_back(buf);
+    }
+}
+
+RegexCost RegexCostAnalyzer::analyze(const std::string& source, const std::regex& regex,
+                                     const std::vector<std::string>& anchors,
+                                     const RegexCostBudget& budget) {
+    RegexCost cost;
+    cost.warnings = structuralIssues(source);
+    probe(regex, source, anchors, budget, cost);
+    return cost;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <regex>
+
+/**
+ * @struct RegexCostBudget
+ * @brief Допустимая стоимость regex при загрузке паттернов
+ */
+struct RegexCostBudget {
+    double probe_budget_ms = 100.0;     ///< Предел времени пробы (дольше - пробы останавливаются с предупреждением)
+    double slow_ns_per_byte = 2000.0;   ///< Дороже на самой длинной пробе - предупреждение
+    size_t max_probe_bytes = 2048;      ///< Размер самой длинной пробы
+    size_t probe_repeats = 3;           ///< Повторов каждой пробы (берется минимальное время)
+    double total_budget_ms = 500.0;     ///< Предел суммарного времени всех проб одного паттерна
+    bool enabled = true;                ///< Выполнять анализ при загрузке
+};
+
+/**
+ * @struct RegexCost
+ * @brief Результат анализа стоимости одного regex
+ */
+struct RegexCost {
+    std::vector<std::string> warnings;      ///< Подозрительные конструкции и медленные пробы
+    std::vector<std::string> violations;    ///< Превышения бюджета (паттерн отклоняется)
+    double worst_ns_per_byte = 0.0;         ///< Стоимость байта на самой дорогой длинной пробе
+    std::string worst_probe;                ///< Имя самой дорогой пробы
+
+    bool rejected() const { return !violations.empty(); }
+};
+
+/**
+ * @class RegexCostAnalyzer
+ * @brief Оценка стоимости regex до начала сканирования
+ *
+ * std::regex работает перебором с возвратами, поэтому вложенные
+ * квантификаторы ((a+)+) и неоднозначные альтернативы под повтором
+ * ((a|ab)*) дают экспоненциальное время на неудачных входах, а
+ * неограниченный квантификатор в начале (.*secret) - квадратичное на
+ * длинных строках. Анализ состоит из двух частей: структурной проверки
+ * текста regex и замера на небольших враждебных пробах с растущей длиной.
+ */
+class RegexCostAnalyzer {
+public:
+    RegexCostAnalyzer() = default;
+    ~RegexCostAnalyzer() = default;
+
+    /**
+     * Полный анализ: структура и пробы
+     * @param source Исходный текст regex (ECMAScript)
+     * @param regex Скомпилированный regex
+     * @param anchors Якоря паттерна (из RegexPrefilter) - пробы строятся и из них
+     * @param budget Бюджет
+     */
+    static RegexCost analyze(const std::string& source, const std::regex& regex,
+                             const std::vector<std::string>& anchors,
+                             const RegexCostBudget& budget);
+
+    /**
+     * Структурная проверка текста regex
+     * @return Описание найденных проблем (пусто - проблем нет)
+     */
+    static std::vector<std::string> structuralIssues(const std::string& source);
+
+    /**
+     * Замер на враждебных пробах
+     * Длина каждой пробы растет мелкими шагами, каждый шаг замеряется
+     * несколько раз. Паттерн отклоняется по росту минимального времени
+     * между соседними длинами (экспонента), а не по одному замеру:
+     * превышение бюджета без такого роста дает только предупреждение.
+     * Семейство проб останавливается на первом шаге сверх бюджета или с
+     * полиномиальным ростом, все пробы паттерна - по total_budget_ms.
+     */
+    static void probe(const std::regex& regex, const std::string& source,
+                      const std::vector<std::string>& anchors,
+                      const RegexCostBudget& budget, RegexCost& cost);
+};
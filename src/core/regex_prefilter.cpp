@@ -0,0 +1,481 @@
+#include "core/regex_prefilter.h"
+#include <set>
+#include <optional>
+#include <algorithm>
+#include <limits>
+
+namespace {
+    using LiteralSet = std::set<std::string>;
+
+    constexpr size_t MAX_EXACT = 16;        ///< Предел точного набора (перемножается при конкатенации)
+    constexpr size_t MAX_REQUIRED = 64;     ///< Предел набора якорей
+    constexpr size_t MAX_CLASS = 4;         ///< Класс символов шире - уже не литерал
+    constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+    /**
+     * Что известно о подвыражении
+     * exact - все строки, с которыми оно может совпасть (небольшой конечный набор);
+     * required - строки, одна из которых входит в любое его совпадение.
+     * Если не задано ни то ни другое - подвыражение совпадает с чем угодно.
+     */
+    struct Info {
+        std::optional<LiteralSet> exact;
+        std::optional<LiteralSet> required;
+
+        static Info any() { return Info(); }
+
+        static Info empty() {
+            Info info;
+            info.exact = LiteralSet{""};
+            return info;
+        }
+    };
+
+    size_t minLength(const LiteralSet& set) {
+        size_t result = UNBOUNDED;
+        for (const auto& str : set) {
+            result = std::min(result, str.size());
+        }
+        return result;
+    }
+
+    /**
+     * Набор, пригодный как якоря (пустая строка встречается везде - не годится)
+     */
+    std::optional<LiteralSet> asRequired(const std::optional<LiteralSet>& set) {
+        if (!set || set->empty() || set->count("")) {
+            return std::nullopt;
+        }
+        return set;
+    }
+
+    std::optional<LiteralSet> requiredOf(const Info& info) {
+        return asRequired(info.exact ? info.exact : info.required);
+    }
+
+    /**
+     * Более избирательный из двух наборов: длиннее самая короткая строка, затем меньше строк
+     */
+    std::optional<LiteralSet> better(const std::optional<LiteralSet>& a,
+                                     const std::optional<LiteralSet>& b) {
+        if (!a) return b;
+        if (!b) return a;
+        size_t len_a = minLength(*a);
+        size_t len_b = minLength(*b);
+        if (len_a != len_b) {
+            return len_a > len_b ? a : b;
+        }
+        return a->size() <= b->size() ? a : b;
+    }
+
+    char lowerAscii(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        c = lowerAscii(c);
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    /**
+     * Рекурсивный разбор подмножества ECMAScript, которое понимает std::regex
+     */
+    class Parser {
+    public:
+        Parser(const std::string& regex, bool icase) : src(regex), icase(icase) {}
+
+        bool parse(Info& out) {
+            Info info = alternation();
+            if (failed || pos != src.size()) {
+                return false;
+            }
+            out = std::move(info);
+            return true;
+        }
+
+    private:
+        const std::string& src;
+        bool icase;
+        size_t pos = 0;
+        bool failed = false;
+
+        bool atEnd() const { return pos >= src.size(); }
+
+        Info fail() {
+            failed = true;
+            return Info::any();
+        }
+
+        Info literal(char c) {
+            // без учета регистра не-ASCII байт сравнивается через локаль - не литерал
+            if (icase && static_cast<unsigned char>(c) >= 0x80) {
+                return Info::any();
+            }
+            Info info;
+            info.exact = LiteralSet{std::string(1, icase ? lowerAscii(c) : c)};
+            return info;
+        }
+
+        Info unite(const Info& a, const Info& b) {
+            Info result;
+            if (a.exact && b.exact) {
+                LiteralSet merged = *a.exact;
+                merged.insert(b.exact->begin(), b.exact->end());
+                if (merged.size() <= MAX_EXACT) {
+                    result.exact = std::move(merged);
+                    return result;
+                }
+            }
+            auto ra = requiredOf(a);
+            auto rb = requiredOf(b);
+            if (ra && rb) {
+                ra->insert(rb->begin(), rb->end());
+                if (ra->size() <= MAX_REQUIRED) {
+                    result.required = std::move(ra);
+                }
+            }
+            return result;
+        }
+
+        Info alternation() {
+            Info left = concatenation();
+            while (!failed && !atEnd() && src[pos] == '|') {
+                ++pos;
+                Info right = concatenation();
+                left = unite(left, right);
+            }
+            return left;
+        }
+
+        Info concatenation() {
+            LiteralSet current{""};     // точные строки текущей цепочки литералов
+            bool exact_chain = true;    // вся конкатенация пока описывается точно
+            std::optional<LiteralSet> best;
+
+            while (!failed && !atEnd() && src[pos] != '|' && src[pos] != ')') {
+                Info item = repetition();
+                if (item.exact) {
+                    LiteralSet product;
+                    for (const auto& head : current) {
+                        for (const auto& tail : *item.exact) {
+                            product.insert(head + tail);
+                        }
+                    }
+                    if (product.size() <= MAX_EXACT) {
+                        current = std::move(product);
+                        continue;
+                    }
+                    // слишком много вариантов - цепочка начинается заново
+                    best = better(best, asRequired(current));
+                    current = *item.exact;
+                    exact_chain = false;
+                    continue;
+                }
+                best = better(best, asRequired(current));
+                best = better(best, requiredOf(item));
+                current = LiteralSet{""};
+                exact_chain = false;
+            }
+
+            Info result;
+            if (exact_chain) {
+                result.exact = std::move(current);
+            } else {
+                result.required = better(best, asRequired(current));
+            }
+            return result;
+        }
+
+        Info repetition() {
+            Info item = atom();
+            while (!failed && !atEnd()) {
+                size_t min_count = 0;
+                size_t max_count = UNBOUNDED;
+                char c = src[pos];
+                if (c == '*') {
+                    ++pos;
+                } else if (c == '+') {
+                    ++pos;
+                    min_count = 1;
+                } else if (c == '?') {
+                    ++pos;
+                    max_count = 1;
+                } else if (c == '{') {
+                    if (!bounds(min_count, max_count)) {
+                        return fail();
+                    }
+                } else {
+                    break;
+                }
+                // ленивый квантификатор совпадает с теми же строками
+                if (!atEnd() && src[pos] == '?') {
+                    ++pos;
+                }
+                item = repeat(item, min_count, max_count);
+            }
+            return item;
+        }
+
+        Info repeat(const Info& item, size_t min_count, size_t max_count) {
+            Info result;
+            if (min_count == 0) {
+                if (max_count == 1 && item.exact) {
+                    result.exact = *item.exact;
+                    result.exact->insert("");
+                }
+                return result;
+            }
+            if (min_count == 1 && max_count == 1) {
+                return item;
+            }
+            // хотя бы одно повторение обязательно
+            result.required = requiredOf(item);
+            return result;
+        }
+
+        bool number(size_t& out) {
+            size_t start = pos;
+            out = 0;
+            while (!atEnd() && src[pos] >= '0' && src[pos] <= '9') {
+                out = std::min<size_t>(out * 10 + (src[pos] - '0'), 1u << 20);
+                ++pos;
+            }
+            return pos > start;
+        }
+
+        bool bounds(size_t& min_count, size_t& max_count) {
+            ++pos;  // '{'
+            if (!number(min_count)) {
+                return false;
+            }
+            max_count = min_count;
+            if (!atEnd() && src[pos] == ',') {
+                ++pos;
+                if (!number(max_count)) {
+                    max_count = UNBOUNDED;
+                }
+            }
+            if (atEnd() || src[pos] != '}') {
+                return false;
+            }
+            ++pos;
+            return true;
+        }
+
+        Info atom() {
+            char c = src[pos++];
+            switch (c) {
+                case '(': return group();
+                case '[': return charClass();
+                case '.': return Info::any();
+                case '^':
+                case '$': return Info::empty();
+                case '\\': return escape();
+                case '*':
+                case '+':
+                case '?':
+                case '{':
+                case ')': return fail();
+                default: return literal(c);
+            }
+        }
+
+        Info group() {
+            bool lookahead = false;
+            if (src.compare(pos, 2, "?:") == 0) {
+                pos += 2;
+            } else if (src.compare(pos, 2, "?=") == 0 || src.compare(pos, 2, "?!") == 0) {
+                pos += 2;
+                lookahead = true;
+            } else if (!atEnd() && src[pos] == '?') {
+                return fail();
+            }
+
+            Info inner = alternation();
+            if (failed || atEnd() || src[pos] != ')') {
+                return fail();
+            }
+            ++pos;
+            // опережающая проверка не потребляет символов
+            return lookahead ? Info::empty() : inner;
+        }
+
+        /**
+         * Код символа после '\\' (-1 для классов \d, \w, \s и т.п.)
+         */
+        int escapedChar(bool in_class) {
+            if (atEnd()) {
+                failed = true;
+                return -1;
+            }
+            char c = src[pos++];
+            switch (c) {
+                case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+                    return -1;
+                case 'n': return '\n';
+                case 't': return '\t';
+                case 'r': return '\r';
+                case 'f': return '\f';
+                case 'v': return '\v';
+                case '0': return '\0';
+                case 'b': return in_class ? '\b' : -1;
+                case 'c':
+                    if (!atEnd()) ++pos;
+                    return -1;
+                case 'x':
+                case 'u': {
+                    size_t digits = c == 'x' ? 2 : 4;
+                    int value = 0;
+                    for (size_t i = 0; i < digits; ++i) {
+                        int digit = atEnd() ? -1 : hexValue(src[pos]);
+                        if (digit < 0) {
+                            failed = true;
+                            return -1;
+                        }
+                        value = value * 16 + digit;
+                        ++pos;
+                    }
+                    return value < 0x80 ? value : -1;
+                }
+                default:
+                    return static_cast<unsigned char>(c);
+            }
+        }
+
+        Info escape() {
+            if (atEnd()) {
+                return fail();
+            }
+            char c = src[pos];
+            if (c == 'b' || c == 'B') {
+                ++pos;
+                return Info::empty();
+            }
+            if (c >= '1' && c <= '9') {
+                // обратная ссылка - текст группы заранее неизвестен
+                while (!atEnd() && src[pos] >= '0' && src[pos] <= '9') {
+                    ++pos;
+                }
+                return Info::any();
+            }
+            int value = escapedChar(false);
+            if (failed || value < 0) {
+                return Info::any();
+            }
+            return literal(static_cast<char>(value));
+        }
+
+        Info charClass() {
+            bool negated = false;
+            if (!atEnd() && src[pos] == '^') {
+                negated = true;
+                ++pos;
+            }
+
+            std::set<int> chars;
+            bool wide = false;
+            bool closed = false;
+            while (!failed && !atEnd()) {
+                char c = src[pos++];
+                if (c == ']') {
+                    closed = true;
+                    break;
+                }
+                if (c == '[' && !atEnd() && (src[pos] == ':' || src[pos] == '.' || src[pos] == '=')) {
+                    // [:upper:], [.x.], [=x=] - набор символов не разбирается
+                    size_t close = src.find(std::string(1, src[pos]) + "]", pos + 1);
+                    if (close == std::string::npos) {
+                        return fail();
+                    }
+                    pos = close + 2;
+                    wide = true;
+                    continue;
+                }
+                int first = c == '\\' ? escapedChar(true) : static_cast<unsigned char>(c);
+                if (first < 0) {
+                    wide = true;
+                    continue;
+                }
+                if (pos + 1 < src.size() && src[pos] == '-' && src[pos + 1] != ']') {
+                    ++pos;
+                    char d = src[pos++];
+                    int last = d == '\\' ? escapedChar(true) : static_cast<unsigned char>(d);
+                    if (last < 0 || last - first >= static_cast<int>(MAX_CLASS)) {
+                        wide = true;
+                        continue;
+                    }
+                    for (int x = first; x <= last; ++x) {
+                        chars.insert(x);
+                    }
+                    continue;
+                }
+                chars.insert(first);
+            }
+            if (failed || !closed) {
+                return fail();
+            }
+            if (negated || wide || chars.empty()) {
+                return Info::any();
+            }
+
+            LiteralSet set;
+            for (int ch : chars) {
+                Info item = literal(static_cast<char>(ch));
+                if (!item.exact) {
+                    return Info::any();
+                }
+                set.insert(*item.exact->begin());
+            }
+            if (set.size() > MAX_CLASS) {
+                return Info::any();
+            }
+            Info info;
+            info.exact = std::move(set);
+            return info;
+        }
+    };
+}
+
+std::vector<std::string> RegexPrefilter::extractAnchors(const std::string& regex, bool icase) {
+    Info info;
+    Parser parser(regex, icase);
+    if (!parser.parse(info)) {
+        return {};
+    }
+
+    auto set = requiredOf(info);
+    if (!set || minLength(*set) < MIN_ANCHOR_LENGTH) {
+        return {};
+    }
+
+    // строка, содержащая другой якорь, ничего не добавляет к проверке
+    std::vector<std::string> anchors;
+    for (const auto& candidate : *set) {
+        bool redundant = std::any_of(set->begin(), set->end(), [&](const std::string& other) {
+            return other != candidate && candidate.find(other) != std::string::npos;
+        });
+        if (!redundant) {
+            anchors.push_back(candidate);
+        }
+    }
+    return anchors;
+}
+
+bool RegexPrefilter::containsAny(std::string_view text, const std::vector<std::string>& anchors) {
+    for (const auto& anchor : anchors) {
+        if (text.find(anchor) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string RegexPrefilter::toLowerAscii(const std::string& text) {
+    std::string result(text);
+    for (char& c : result) {
+        c = lowerAscii(c);
+    }
+    return result;
+}
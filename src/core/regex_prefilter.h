@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class RegexPrefilter
+ * @brief Анализ regex на обязательные литералы (якоря)
+ *
+ * Якоря - набор строк, одна из которых обязательно входит в любое
+ * совпадение regex. Если ни одного якоря в тексте нет, regex заведомо
+ * ничего не найдет и запускать его не нужно. Анализ консервативный:
+ * для конструкций, которые он не понимает, якоря не выводятся вовсе.
+ */
+class RegexPrefilter {
+public:
+    RegexPrefilter() = default;
+    ~RegexPrefilter() = default;
+
+    /**
+     * Минимальная длина якоря: короткие литералы есть почти в любом файле
+     */
+    static constexpr size_t MIN_ANCHOR_LENGTH = 3;
+
+    /**
+     * Вывести якоря для regex (синтаксис ECMAScript)
+     * @param regex Исходный текст regex
+     * @param icase Regex без учета регистра (якоря приводятся к нижнему регистру)
+     * @return Якоря или пустой вектор, если префильтр для regex невозможен
+     */
+    static std::vector<std::string> extractAnchors(const std::string& regex, bool icase);
+
+    /**
+     * Есть ли в тексте хотя бы один из якорей
+     * @param text Текст (для icase - уже в нижнем регистре, см. toLowerAscii)
+     * @param anchors Якоря из extractAnchors
+     */
+    static bool containsAny(std::string_view text, const std::vector<std::string>& anchors);
+
+    /**
+     * Привести ASCII буквы к нижнему регистру (остальные байты не меняются)
+     */
+    static std::string toLowerAscii(const std::string& text);
+};
@@ -0,0 +1,404 @@
+#include "core/scan_server.h"
+#include "core/file_scanner.h"
+#include "utils/ndjson_writer.h"
+#include "utils/output_sink.h"
+#include "utils/logger.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // как часто ожидание accept / recv проверяет флаг остановки
+    constexpr int ACCEPT_POLL_MS = 200;
+
+    /**
+     * Запись в сокет: строка накапливается и отправляется по flush()
+     * (MSG_NOSIGNAL - отключившийся клиент не убивает сервер SIGPIPE)
+     */
+    class SocketSink : public OutputSink {
+    public:
+        explicit SocketSink(int socket_fd) : fd(socket_fd) {}
+
+        void write(const char* data, size_t size) override { buffer.append(data, size); }
+        using OutputSink::write;
+
+        void flush() override {
+            size_t sent = 0;
+            while (!error && sent < buffer.size()) {
+                ssize_t n = ::send(fd, buffer.data() + sent, buffer.size() - sent, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    error = true;
+                    break;
+                }
+                sent += static_cast<size_t>(n);
+            }
+            buffer.clear();
+        }
+
+        bool failed() const override { return error; }
+
+    private:
+        int fd;
+        std::string buffer;
+        bool error = false;
+    };
+
+    bool fillAddress(const std::string& path, sockaddr_un& address) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    void sendLine(int fd, const json& message) {
+        SocketSink sink(fd);
+        sink.write(message.dump(-1, ' ', false, json::error_handler_t::replace));
+        sink.write("\n", 1);
+        sink.flush();
+    }
+
+    void sendError(int fd, const std::string& message) {
+        sendLine(fd, {{"type", "error"}, {"message", message}});
+    }
+
+    std::vector<std::string> stringList(const json& request, const char* key) {
+        std::vector<std::string> values;
+        if (request.contains(key)) {
+            for (const auto& value : request.at(key)) {
+                values.push_back(value.get<std::string>());
+            }
+        }
+        return values;
+    }
+}
+
+ScanServer::ScanServer(const SecretDetector& d, ScanOptions options, std::string path, size_t count)
+    : detector(d), defaults(std::move(options)), socket_path(std::move(path)),
+      handler_count(std::max<size_t>(count, 1)) {
+    if (!defaults.cancel) {
+        defaults.cancel = std::make_shared<CancellationToken>();
+    }
+}
+
+ScanServer::~ScanServer() {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+    }
+    pending_cv.notify_all();
+    for (auto& handler : handlers) {
+        if (handler.joinable()) {
+            handler.join();
+        }
+    }
+    closeSocket();
+}
+
+bool ScanServer::start() {
+    sockaddr_un address;
+    if (!fillAddress(socket_path, address)) {
+        LOG_ERROR_FMT("Invalid socket path (at most {} bytes): {}", sizeof(address.sun_path) - 1,
+                      socket_path);
+        return false;
+    }
+
+    // сокет от упавшего сервера мешает bind - удалить, если никто не отвечает
+    struct stat st{};
+    if (::lstat(socket_path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            LOG_ERROR_FMT("{} exists and is not a socket", socket_path);
+            return false;
+        }
+        ScanClient probe(socket_path);
+        if (probe.connect()) {
+            LOG_ERROR_FMT("Another server is already listening on {}", socket_path);
+            return false;
+        }
+        ::unlink(socket_path.c_str());
+    }
+
+    listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        LOG_ERROR_FMT("Cannot create socket: {}", std::strerror(errno));
+        return false;
+    }
+
+    // права 0600 с момента создания: через сокет проходят сами секреты
+    mode_t old_mask = ::umask(0177);
+    int bound = ::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    ::umask(old_mask);
+    if (bound != 0 || ::listen(listen_fd, SOMAXCONN) != 0) {
+        LOG_ERROR_FMT("Cannot listen on {}: {}", socket_path, std::strerror(errno));
+        ::close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+
+    for (size_t i = 0; i < handler_count; ++i) {
+        handlers.emplace_back(&ScanServer::handlerLoop, this);
+    }
+    LOG_INFO_FMT("Listening on {} ({} patterns loaded)", socket_path,
+                 detector.getMatcher().getPatternCount());
+    return true;
+}
+
+void ScanServer::run() {
+    while (!stopping.load(std::memory_order_relaxed)) {
+        pollfd waiter{listen_fd, POLLIN, 0};
+        int ready = ::poll(&waiter, 1, ACCEPT_POLL_MS);
+        if (ready <= 0) {
+            continue;  // таймаут или EINTR от сигнала - проверить флаг
+        }
+
+        int client = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno != EINTR && errno != EAGAIN) {
+                LOG_WARN_FMT("accept failed: {}", std::strerror(errno));
+            }
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        pending.push(client);
+        pending_cv.notify_one();
+    }
+
+    LOG_INFO_FMT("Server stopping after {} requests", requestsServed());
+    {
+        // флаг ставится без блокировки - разбудить под мьютексом, чтобы не потерять сигнал
+        std::lock_guard<std::mutex> lock(pending_mutex);
+    }
+    pending_cv.notify_all();
+    for (auto& handler : handlers) {
+        handler.join();
+    }
+    handlers.clear();
+
+    // соединения, которые не успели взять в работу
+    while (!pending.empty()) {
+        ::close(pending.front());
+        pending.pop();
+    }
+    closeSocket();
+}
+
+void ScanServer::handlerLoop() {
+    while (true) {
+        int client;
+        {
+            std::unique_lock<std::mutex> lock(pending_mutex);
+            pending_cv.wait(lock, [this]() {
+                return !pending.empty() || stopping.load(std::memory_order_relaxed);
+            });
+            if (pending.empty()) {
+                return;
+            }
+            client = pending.front();
+            pending.pop();
+        }
+        serveConnection(client);
+        ::close(client);
+    }
+}
+
+void ScanServer::serveConnection(int fd) {
+    std::string buffer;
+    char chunk[64 * 1024];
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+        size_t newline = buffer.find('\n');
+        if (newline != std::string::npos) {
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (line.empty()) {
+                continue;
+            }
+            if (!handleRequest(fd, line)) {
+                return;
+            }
+            continue;
+        }
+
+        if (buffer.size() > MAX_REQUEST_BYTES) {
+            sendError(fd, "request too large");
+            return;
+        }
+
+        // ожидание с таймаутом: простаивающий клиент не задерживает остановку
+        pollfd waiter{fd, POLLIN, 0};
+        if (::poll(&waiter, 1, ACCEPT_POLL_MS) <= 0) {
+            continue;
+        }
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;  // клиент закрыл соединение
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+bool ScanServer::handleRequest(int fd, const std::string& line) {
+    auto start_time = std::chrono::steady_clock::now();
+    requests.fetch_add(1, std::memory_order_relaxed);
+
+    try {
+        json request = json::parse(line);
+        std::string type = request.value("type", "");
+
+        if (type == "ping") {
+            sendLine(fd, {{"type", "pong"}, {"version", VERSION},
+                          {"patterns", detector.getMatcher().getPatternCount()},
+                          {"requests", requestsServed()}});
+            return true;
+        }
+
+        if (type == "shutdown") {
+            LOG_INFO("Shutdown requested by client");
+            sendLine(fd, {{"type", "bye"}});
+            stop();
+            return false;
+        }
+
+        SocketSink sink(fd);
+        NdjsonWriter writer(sink);
+        ScanStatistics statistics;
+
+        if (type == "scan") {
+            ScanOptions options = defaults;
+            options.scan_path = request.at("path").get<std::string>();
+            if (options.scan_path.empty() || options.scan_path[0] != '/') {
+                sendError(fd, "path must be absolute");
+                return true;
+            }
+            options.recursive = request.value("recursive", options.recursive);
+            options.respect_gitignore = request.value("gitignore", options.respect_gitignore);
+            if (request.contains("exclude")) {
+                options.exclude_patterns = stringList(request, "exclude");
+            }
+            if (request.contains("include_ext")) {
+                options.include_extensions = stringList(request, "include_ext");
+            }
+
+            // находки уходят клиенту прямо из рабочих потоков сканера
+            FileScanner scanner(options);
+            scanner.setMatchCallback([&writer](const Match& match) {
+                writer.writeFinding(match);
+            });
+            scanner.scan(detector.getMatcher());
+            statistics = scanner.getStatistics();
+        } else if (type == "scan_buffer") {
+            const std::string& data = request.at("data").get_ref<const std::string&>();
+            std::string name = request.value("name", "<buffer>");
+            ScanResult result = detector.scanBuffer(data.data(), data.size(), name, defaults);
+            for (const auto& match : result.matches) {
+                writer.writeFinding(match);
+            }
+            statistics = result.statistics;
+        } else {
+            sendError(fd, "unknown request type: " + type);
+            return true;
+        }
+
+        writer.writeSummary(statistics, statistics.critical_count > 0, statistics.high_count > 0);
+        LOG_INFO_FMT("{} request: {} findings in {:.1f} ms", type, statistics.total_matches_found,
+                     std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - start_time).count());
+        return !sink.failed();
+    } catch (const std::exception& e) {
+        sendError(fd, std::string("bad request: ") + e.what());
+        return true;
+    }
+}
+
+void ScanServer::closeSocket() {
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        listen_fd = -1;
+        ::unlink(socket_path.c_str());
+    }
+}
+
+ScanClient::ScanClient(std::string path) : socket_path(std::move(path)) {}
+
+ScanClient::~ScanClient() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool ScanClient::connect() {
+    sockaddr_un address;
+    if (!fillAddress(socket_path, address)) {
+        return false;
+    }
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool ScanClient::request(const json& request,
+                         const std::function<void(const std::string&, const json&)>& on_line) {
+    if (fd < 0) {
+        return false;
+    }
+
+    SocketSink sink(fd);
+    // невалидный UTF-8 (например, в stdin) заменяется на U+FFFD
+    sink.write(request.dump(-1, ' ', false, json::error_handler_t::replace));
+    sink.write("\n", 1);
+    sink.flush();
+    if (sink.failed()) {
+        return false;
+    }
+
+    char chunk[64 * 1024];
+    while (true) {
+        size_t newline = buffer.find('\n');
+        if (newline == std::string::npos) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;  // сервер закрыл соединение до конца ответа
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+            continue;
+        }
+
+        std::string line = buffer.substr(0, newline);
+        buffer.erase(0, newline + 1);
+        json message = json::parse(line, nullptr, false);
+        if (message.is_discarded()) {
+            continue;
+        }
+        on_line(line, message);
+
+        std::string type = message.value("type", "");
+        if (type == "error") {
+            return false;
+        }
+        if (type == "summary" || type == "pong" || type == "bye") {
+            return true;
+        }
+    }
+}
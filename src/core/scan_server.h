@@ -0,0 +1,138 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include "core/secret_detector.h"
+
+using json = nlohmann::json;
+
+/**
+ * @class ScanServer
+ * @brief Резидентный сервер сканирования на Unix domain socket
+ *
+ * Паттерны компилируются один раз при запуске, дальше каждый запрос
+ * сразу идет в поиск. Протокол - NDJSON в обе стороны: клиент пишет
+ * запрос одной строкой, сервер отвечает находками по мере обнаружения
+ * (те же записи, что у --format ndjson) и завершает ответ сводкой
+ * или ошибкой. В одном соединении можно отправить несколько запросов.
+ *
+ * Запросы:
+ *   {"type":"scan","path":"/abs/path","recursive":true,"gitignore":true,
+ *    "exclude":[...],"include_ext":[...]}
+ *   {"type":"scan_buffer","name":"file.env","data":"..."}
+ *   {"type":"ping"}       -> {"type":"pong",...}
+ *   {"type":"shutdown"}   -> {"type":"bye"}
+ *
+ * Соединения обслуживает фиксированный пул потоков; сокет создается
+ * с правами 0600 - сканируемые данные видит только владелец.
+ */
+class ScanServer {
+public:
+    static constexpr size_t DEFAULT_HANDLERS = 4;
+    static constexpr size_t MAX_REQUEST_BYTES = 64 * 1024 * 1024;
+
+    /**
+     * @param detector Инициализированный детектор (должен жить дольше сервера)
+     * @param defaults Опции сканирования по умолчанию (baseline, бюджет, потоки)
+     * @param socket_path Путь до сокета
+     * @param handlers Потоков обработки соединений
+     */
+    ScanServer(const SecretDetector& detector, ScanOptions defaults, std::string socket_path,
+               size_t handlers = DEFAULT_HANDLERS);
+    ~ScanServer();
+
+    ScanServer(const ScanServer&) = delete;
+    ScanServer& operator=(const ScanServer&) = delete;
+
+    /**
+     * Создать сокет и начать слушать
+     * Устаревший сокет (сервер не отвечает) удаляется.
+     * @return false если сокет занят или не создан
+     */
+    bool start();
+
+    /**
+     * Принимать соединения до stop() или запроса shutdown
+     */
+    void run();
+
+    /**
+     * Остановить сервер (можно вызывать из обработчика сигнала)
+     * Идущие сканирования отменяются и отвечают частичным результатом.
+     */
+    void stop() {
+        stopping.store(true, std::memory_order_relaxed);
+        defaults.cancel->cancel();
+    }
+
+    /**
+     * Обработано запросов
+     */
+    uint64_t requestsServed() const { return requests.load(std::memory_order_relaxed); }
+
+private:
+    const SecretDetector& detector;
+    ScanOptions defaults;                   ///< defaults.cancel - общий для всех запросов
+    std::string socket_path;
+    size_t handler_count;
+    int listen_fd = -1;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> requests{0};
+
+    std::vector<std::thread> handlers;
+    std::queue<int> pending;                ///< Принятые соединения
+    std::mutex pending_mutex;
+    std::condition_variable pending_cv;
+
+    void handlerLoop();
+    void serveConnection(int fd);
+
+    /**
+     * Выполнить один запрос, ответ пишется в fd
+     * @return false если соединение нужно закрыть
+     */
+    bool handleRequest(int fd, const std::string& line);
+
+    void closeSocket();
+};
+
+/**
+ * @class ScanClient
+ * @brief Клиент ScanServer: отправить запрос и получать ответ построчно
+ */
+class ScanClient {
+public:
+    explicit ScanClient(std::string socket_path);
+    ~ScanClient();
+
+    ScanClient(const ScanClient&) = delete;
+    ScanClient& operator=(const ScanClient&) = delete;
+
+    /**
+     * Подключиться к серверу
+     */
+    bool connect();
+
+    /**
+     * Отправить запрос и читать ответ до завершающей записи
+     * (summary, error, pong или bye)
+     * @param request Запрос
+     * @param on_line Вызывается для каждой строки ответа (сырая строка и разобранный JSON)
+     * @return false при ошибке соединения или ответе error
+     */
+    bool request(const json& request,
+                 const std::function<void(const std::string&, const json&)>& on_line);
+
+private:
+    std::string socket_path;
+    int fd = -1;
+    std::string buffer;     ///< Прочитанные, но еще не разобранные данные
+};
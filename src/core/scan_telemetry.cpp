@@ -0,0 +1,106 @@
+#include "core/scan_telemetry.h"
+
+namespace {
+    // вес нового замера при сглаживании скорости
+    constexpr double RATE_SMOOTHING = 0.3;
+
+    int64_t nowNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+void ScanTelemetry::begin(uint64_t total_files, uint64_t total_bytes) {
+    files_total.store(total_files, std::memory_order_relaxed);
+    bytes_total.store(total_bytes, std::memory_order_relaxed);
+    int64_t expected = 0;
+    start_ns.compare_exchange_strong(expected, nowNanoseconds());
+}
+
+TelemetrySnapshot ScanTelemetry::snapshot() const {
+    TelemetrySnapshot snap;
+    snap.finished = finished.load(std::memory_order_acquire);
+    snap.files_total = files_total.load(std::memory_order_relaxed);
+    snap.bytes_total = bytes_total.load(std::memory_order_relaxed);
+    snap.files_done = files_done.load(std::memory_order_relaxed);
+    snap.bytes_done = bytes_done.load(std::memory_order_relaxed);
+    snap.matches = match_count.load(std::memory_order_relaxed);
+
+    int64_t start = start_ns.load(std::memory_order_relaxed);
+    if (start != 0) {
+        snap.elapsed_seconds = (nowNanoseconds() - start) / 1e9;
+    }
+    return snap;
+}
+
+TelemetrySnapshot TelemetrySampler::sample() {
+    return update(telemetry.snapshot());
+}
+
+TelemetrySnapshot TelemetrySampler::update(TelemetrySnapshot snap) {
+    double dt = snap.elapsed_seconds - previous.elapsed_seconds;
+    if (!has_previous) {
+        // первый замер - средняя скорость с начала
+        if (snap.elapsed_seconds > 0) {
+            files_rate = snap.files_done / snap.elapsed_seconds;
+            bytes_rate = snap.bytes_done / snap.elapsed_seconds;
+        }
+    } else if (dt > 0) {
+        double files_now = (snap.files_done - previous.files_done) / dt;
+        double bytes_now = (snap.bytes_done - previous.bytes_done) / dt;
+        files_rate += RATE_SMOOTHING * (files_now - files_rate);
+        bytes_rate += RATE_SMOOTHING * (bytes_now - bytes_rate);
+    }
+
+    snap.files_per_second = files_rate;
+    snap.bytes_per_second = bytes_rate;
+
+    // ETA по байтам (файлы бывают очень разного размера), иначе по файлам
+    if (snap.finished) {
+        snap.eta_seconds = 0.0;
+    } else if (snap.bytes_total > 0 && bytes_rate > 0) {
+        uint64_t left = snap.bytes_total > snap.bytes_done ? snap.bytes_total - snap.bytes_done : 0;
+        snap.eta_seconds = left / bytes_rate;
+    } else if (snap.files_total > 0 && files_rate > 0) {
+        uint64_t left = snap.files_total > snap.files_done ? snap.files_total - snap.files_done : 0;
+        snap.eta_seconds = left / files_rate;
+    }
+
+    previous = snap;
+    has_previous = true;
+    return snap;
+}
+
+TelemetryReporter::TelemetryReporter(const ScanTelemetry& telemetry,
+                                     std::chrono::milliseconds interval_ms,
+                                     std::function<void(const TelemetrySnapshot&)> callback)
+    : sampler(telemetry), interval(interval_ms), on_sample(std::move(callback)) {
+    thread = std::thread(&TelemetryReporter::run, this);
+}
+
+TelemetryReporter::~TelemetryReporter() {
+    stop();
+}
+
+void TelemetryReporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return;
+        }
+        stopping = true;
+    }
+    cv.notify_one();
+    thread.join();
+}
+
+void TelemetryReporter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!cv.wait_for(lock, interval, [this] { return stopping; })) {
+        lock.unlock();
+        on_sample(sampler.sample());
+        lock.lock();
+    }
+    lock.unlock();
+    on_sample(sampler.sample());
+}
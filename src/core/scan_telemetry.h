@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * @struct TelemetrySnapshot
+ * @brief Срез телеметрии сканирования в момент опроса
+ */
+struct TelemetrySnapshot {
+    uint64_t files_total = 0;       ///< Файлов к сканированию (0 - неизвестно)
+    uint64_t files_done = 0;        ///< Обработано файлов
+    uint64_t bytes_total = 0;       ///< Байт к сканированию (0 - неизвестно)
+    uint64_t bytes_done = 0;        ///< Обработано байт
+    uint64_t matches = 0;           ///< Найдено совпадений
+    double elapsed_seconds = 0.0;   ///< Время с начала сканирования
+    double files_per_second = 0.0;  ///< Текущая скорость (сглаженная)
+    double bytes_per_second = 0.0;  ///< Текущая скорость (сглаженная)
+    double eta_seconds = -1.0;      ///< Оценка оставшегося времени (-1 - неизвестно)
+    bool finished = false;
+
+    /**
+     * Процент выполнения (по байтам, если известен объем, иначе по файлам)
+     */
+    int percent() const {
+        // файлы могут вырасти после обхода - больше 100% не показывается
+        if (bytes_total > 0) return static_cast<int>(std::min(bytes_done, bytes_total) * 100 / bytes_total);
+        if (files_total > 0) return static_cast<int>(std::min(files_done, files_total) * 100 / files_total);
+        return 0;
+    }
+};
+
+/**
+ * @class ScanTelemetry
+ * @brief Счетчики прогресса, которые рабочие потоки обновляют без блокировок
+ *
+ * Рабочие потоки только увеличивают атомарные счетчики (memory_order_relaxed),
+ * никакого кода UI в горячем пути нет. Отображение строится отдельно:
+ * TelemetrySampler / TelemetryReporter опрашивают счетчики по таймеру.
+ */
+class ScanTelemetry {
+public:
+    ScanTelemetry() = default;
+
+    /**
+     * Начало сканирования: известный объем работы
+     */
+    void begin(uint64_t total_files, uint64_t total_bytes);
+
+    /**
+     * Файл обработан
+     */
+    void recordFile(uint64_t bytes, uint64_t matches) {
+        files_done.fetch_add(1, std::memory_order_relaxed);
+        bytes_done.fetch_add(bytes, std::memory_order_relaxed);
+        match_count.fetch_add(matches, std::memory_order_relaxed);
+    }
+
+    /**
+     * Обработан блок потока (stdin)
+     */
+    void recordBytes(uint64_t bytes, uint64_t matches) {
+        bytes_done.fetch_add(bytes, std::memory_order_relaxed);
+        match_count.fetch_add(matches, std::memory_order_relaxed);
+    }
+
+    /**
+     * Сканирование завершено
+     */
+    void finish() { finished.store(true, std::memory_order_release); }
+
+    /**
+     * Накопительные значения (скорость и ETA не заполняются)
+     */
+    TelemetrySnapshot snapshot() const;
+
+private:
+    // счетчики на разных кэш-линиях, чтобы потоки не мешали друг другу
+    alignas(64) std::atomic<uint64_t> files_done{0};
+    alignas(64) std::atomic<uint64_t> bytes_done{0};
+    alignas(64) std::atomic<uint64_t> match_count{0};
+    alignas(64) std::atomic<uint64_t> files_total{0};
+    std::atomic<uint64_t> bytes_total{0};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<bool> finished{false};
+};
+
+/**
+ * @class TelemetrySampler
+ * @brief Расчет текущей скорости и ETA по последовательным срезам
+ *
+ * Не потокобезопасен: используется одним опрашивающим (таймер GUI
+ * или поток TelemetryReporter).
+ */
+class TelemetrySampler {
+public:
+    explicit TelemetrySampler(const ScanTelemetry& telemetry) : telemetry(telemetry) {}
+
+    /**
+     * Снять срез и обновить скорость (экспоненциальное сглаживание)
+     */
+    TelemetrySnapshot sample();
+
+    /**
+     * Обновить скорость и ETA по готовому срезу
+     * То же, что sample(), но время задает вызывающий (elapsed_seconds).
+     */
+    TelemetrySnapshot update(TelemetrySnapshot snap);
+
+private:
+    const ScanTelemetry& telemetry;
+    TelemetrySnapshot previous;
+    double files_rate = 0.0;
+    double bytes_rate = 0.0;
+    bool has_previous = false;
+};
+
+/**
+ * @class TelemetryReporter
+ * @brief Поток, который опрашивает телеметрию с заданным интервалом
+ *
+ * Callback вызывается только из потока репортера, последний раз -
+ * после stop() с финальным срезом.
+ */
+class TelemetryReporter {
+public:
+    TelemetryReporter(const ScanTelemetry& telemetry,
+                      std::chrono::milliseconds interval,
+                      std::function<void(const TelemetrySnapshot&)> on_sample);
+    ~TelemetryReporter();
+
+    TelemetryReporter(const TelemetryReporter&) = delete;
+    TelemetryReporter& operator=(const TelemetryReporter&) = delete;
+
+    /**
+     * Остановить опрос (вызывает callback с финальным срезом)
+     */
+    void stop();
+
+private:
+    TelemetrySampler sampler;
+    std::chrono::milliseconds interval;
+    std::function<void(const TelemetrySnapshot&)> on_sample;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread thread;
+
+    void run();
+};
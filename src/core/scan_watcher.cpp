@@ -0,0 +1,355 @@
+#include "core/scan_watcher.h"
+#include "utils/logger.h"
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                                    IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+    // непрерывный поток событий (сборка, git checkout) все равно обрабатывается не реже
+    constexpr int MAX_BATCH_MS = 2000;
+    // как часто run() проверяет флаг остановки
+    constexpr int STOP_POLL_MS = 500;
+
+    // ключ находки как у отпечатка baseline - без номера строки
+    std::string findingKey(const Match& match) {
+        return match.pattern_name + '\0' + match.matched_text;
+    }
+}
+
+ScanWatcher::ScanWatcher(const PatternMatcher& m, ScanOptions opts, int debounce)
+    : matcher(m), options(std::move(opts)), scanner(std::make_unique<FileScanner>(options)),
+      debounce_ms(debounce) {}
+
+ScanWatcher::~ScanWatcher() {
+    if (inotify_fd >= 0) {
+        ::close(inotify_fd);
+    }
+}
+
+bool ScanWatcher::start() {
+    std::error_code ec;
+    if (!fs::is_directory(options.scan_path, ec)) {
+        LOG_ERROR_FMT("Watch mode needs a directory: {}", options.scan_path);
+        return false;
+    }
+
+    inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        LOG_ERROR_FMT("Cannot start inotify: {}", std::strerror(errno));
+        return false;
+    }
+
+    // подписка до сканирования: изменения во время него не теряются
+    watchTree(options.scan_path, nullptr);
+
+    FileScanner initial(options);
+    for (auto& match : initial.scan(matcher)) {
+        findings[match.file_path].push_back(std::move(match));
+    }
+    initial_statistics = initial.getStatistics();
+
+    LOG_INFO_FMT("Watching {} directories under {}", watches.size(), options.scan_path);
+    return true;
+}
+
+bool ScanWatcher::skipDirectory(const std::string& path) {
+    if (fs::path(path).filename() == ".git") {
+        return true;
+    }
+    // паттерны .gitignore вида "build/" сравниваются с путем директории со слэшем
+    return scanner->isIgnored(path + "/");
+}
+
+void ScanWatcher::watchTree(const std::string& directory, std::set<std::string>* changed) {
+    auto add_watch = [this](const std::string& dir) {
+        int wd = ::inotify_add_watch(inotify_fd, dir.c_str(), WATCH_MASK);
+        if (wd < 0) {
+            if (!watch_limit_reported) {
+                LOG_WARN_FMT("Cannot watch {}: {} (raise fs.inotify.max_user_watches for large trees)",
+                             dir, std::strerror(errno));
+                watch_limit_reported = true;
+            }
+            return;
+        }
+        watches[wd] = dir;
+    };
+
+    add_watch(directory);
+
+    std::error_code ec;
+    fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        const auto& entry = *it;
+        std::string path = entry.path().string();
+        std::error_code type_ec;
+
+        if (entry.is_symlink(type_ec)) {
+            continue;
+        }
+        if (entry.is_directory(type_ec)) {
+            if (!options.recursive || skipDirectory(path)) {
+                it.disable_recursion_pending();
+                continue;
+            }
+            add_watch(path);
+        } else if (changed && entry.is_regular_file(type_ec)) {
+            changed->insert(path);
+        }
+    }
+}
+
+bool ScanWatcher::readEvents(std::set<std::string>& changed) {
+    alignas(inotify_event) char buffer[64 * 1024];
+    bool complete = true;
+
+    while (true) {
+        ssize_t n = ::read(inotify_fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;  // EAGAIN - очередь прочитана
+        }
+
+        for (char* p = buffer; p < buffer + n;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                complete = false;
+                continue;
+            }
+            auto watch = watches.find(event->wd);
+            if (watch == watches.end()) {
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                watches.erase(watch);   // директория удалена
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            std::string path = (fs::path(watch->second) / event->name).string();
+            if (!(event->mask & IN_ISDIR)) {
+                changed.insert(path);
+                continue;
+            }
+
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                // файлы могли появиться до подписки - они сканируются сразу
+                if (options.recursive && !skipDirectory(path)) {
+                    watchTree(path, &changed);
+                }
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                // находки файлов внутри ушедшей директории
+                std::string prefix = path + "/";
+                for (auto it = findings.lower_bound(prefix);
+                     it != findings.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+                    changed.insert(it->first);
+                }
+                // перенесенная директория наблюдается по старому пути - снять подписки
+                for (auto it = watches.begin(); it != watches.end();) {
+                    if (it->second == path || it->second.compare(0, prefix.size(), prefix) == 0) {
+                        ::inotify_rm_watch(inotify_fd, it->first);
+                        it = watches.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+        }
+    }
+
+    return complete;
+}
+
+bool ScanWatcher::waitForChanges(int timeout_ms, WatchUpdate& update) {
+    update = WatchUpdate();
+
+    pollfd waiter{inotify_fd, POLLIN, 0};
+    if (::poll(&waiter, 1, timeout_ms) <= 0) {
+        return false;
+    }
+
+    std::set<std::string> changed;
+    bool complete = readEvents(changed);
+
+    // серия событий собирается в одну пачку: ждать паузы debounce_ms
+    auto batch_start = std::chrono::steady_clock::now();
+    while (!stopping.load(std::memory_order_relaxed) &&
+           std::chrono::steady_clock::now() - batch_start < std::chrono::milliseconds(MAX_BATCH_MS)) {
+        if (::poll(&waiter, 1, debounce_ms) <= 0) {
+            break;
+        }
+        complete = readEvents(changed) && complete;
+    }
+
+    // .gitignore читается сканером один раз: новые правила меняют, какие
+    // файлы и директории видны, - пересканировать все
+    bool gitignore_changed = changed.count((fs::path(options.scan_path) / ".gitignore").string()) > 0;
+    if (!complete || gitignore_changed) {
+        if (!complete) {
+            LOG_WARN("inotify event queue overflowed, rescanning the whole tree");
+        } else {
+            LOG_INFO(".gitignore changed, reloading ignore rules and rescanning the whole tree");
+        }
+        reloadIgnoreRules();
+        rescanAll(update);
+    } else {
+        rescan(changed, update);
+    }
+    return true;
+}
+
+void ScanWatcher::run(const std::function<void(const WatchUpdate&)>& on_update) {
+    while (!stopping.load(std::memory_order_relaxed)) {
+        WatchUpdate update;
+        if (waitForChanges(STOP_POLL_MS, update) && !update.empty()) {
+            on_update(update);
+        }
+    }
+}
+
+void ScanWatcher::rescan(const std::set<std::string>& changed, WatchUpdate& update) {
+    for (const auto& path : changed) {
+        std::vector<Match> matches;
+        std::error_code ec;
+        bool present = fs::is_regular_file(path, ec) && !scanner->isIgnored(path) &&
+                       scanner->shouldScanFile(path);
+
+        if (present) {
+            try {
+                matches = scanner->scanFile(path, matcher);
+                if (options.baseline) {
+                    options.baseline->filter(matches, options.scan_path);
+                }
+                update.files_rescanned++;
+            } catch (const std::exception& e) {
+                LOG_WARN_FMT("Error scanning file {}: {}", path, e.what());
+            }
+        } else if (findings.count(path)) {
+            update.files_removed++;
+        }
+        replaceFindings(path, std::move(matches), update);
+    }
+
+    update.total_findings = 0;
+    for (const auto& [path, matches] : findings) {
+        update.total_findings += matches.size();
+    }
+    LOG_DEBUG_FMT("Rescanned {} of {} changed paths", update.files_rescanned, changed.size());
+}
+
+void ScanWatcher::rescanAll(WatchUpdate& update) {
+    // подписки на директории, созданные за время переполнения
+    watchTree(options.scan_path, nullptr);
+
+    FileScanner full(options);
+    std::map<std::string, std::vector<Match>> fresh;
+    for (auto& match : full.scan(matcher)) {
+        fresh[match.file_path].push_back(std::move(match));
+    }
+    update.files_rescanned = full.getStatistics().total_files_scanned;
+
+    std::set<std::string> paths;
+    for (const auto& [path, matches] : findings) {
+        paths.insert(path);
+    }
+    for (const auto& [path, matches] : fresh) {
+        paths.insert(path);
+    }
+    for (const auto& path : paths) {
+        auto it = fresh.find(path);
+        replaceFindings(path, it != fresh.end() ? std::move(it->second) : std::vector<Match>(), update);
+    }
+
+    update.total_findings = 0;
+    for (const auto& [path, matches] : findings) {
+        update.total_findings += matches.size();
+    }
+}
+
+void ScanWatcher::reloadIgnoreRules() {
+    scanner = std::make_unique<FileScanner>(options);
+
+    // директории под новыми правилами; подписки на ставшие видимыми добавит rescanAll()
+    std::vector<std::string> ignored;
+    for (const auto& [wd, directory] : watches) {
+        if (directory != options.scan_path && skipDirectory(directory)) {
+            ignored.push_back(directory + "/");
+        }
+    }
+    for (auto it = watches.begin(); it != watches.end();) {
+        std::string directory = it->second + "/";
+        bool inside = std::any_of(ignored.begin(), ignored.end(), [&](const std::string& prefix) {
+            return directory.compare(0, prefix.size(), prefix) == 0;
+        });
+        if (inside) {
+            ::inotify_rm_watch(inotify_fd, it->first);
+            it = watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ScanWatcher::replaceFindings(const std::string& file_path, std::vector<Match> matches,
+                                  WatchUpdate& update) {
+    auto current = findings.find(file_path);
+    const std::vector<Match> none;
+    const std::vector<Match>& previous = current != findings.end() ? current->second : none;
+
+    // сравнение мультимножеств: одинаковый секрет дважды в файле - две находки
+    std::multiset<std::string> previous_keys, new_keys;
+    for (const auto& match : previous) {
+        previous_keys.insert(findingKey(match));
+    }
+    for (const auto& match : matches) {
+        new_keys.insert(findingKey(match));
+    }
+
+    for (const auto& match : matches) {
+        auto it = previous_keys.find(findingKey(match));
+        if (it != previous_keys.end()) {
+            previous_keys.erase(it);
+        } else {
+            update.added.push_back(match);
+        }
+    }
+    for (const auto& match : previous) {
+        auto it = new_keys.find(findingKey(match));
+        if (it != new_keys.end()) {
+            new_keys.erase(it);
+        } else {
+            update.removed.push_back(match);
+        }
+    }
+
+    if (matches.empty()) {
+        if (current != findings.end()) {
+            findings.erase(current);
+        }
+    } else {
+        findings[file_path] = std::move(matches);
+    }
+}
+
+std::vector<Match> ScanWatcher::currentMatches() const {
+    std::vector<Match> matches;
+    for (const auto& [path, file_matches] : findings) {
+        matches.insert(matches.end(), file_matches.begin(), file_matches.end());
+    }
+    return matches;
+}
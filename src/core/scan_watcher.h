@@ -0,0 +1,132 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <atomic>
+#include <functional>
+#include "core/file_scanner.h"
+#include "core/watch_update.h"
+
+/**
+ * @class ScanWatcher
+ * @brief Наблюдение за деревом через inotify с пересканированием измененных файлов
+ *
+ * После начального сканирования процесс спит в poll() на дескрипторе inotify.
+ * События (запись и закрытие файла, создание, переименование, удаление)
+ * копятся, пока не наступит пауза debounce_ms, - серия сохранений или
+ * git checkout обрабатывается одной пачкой, каждый файл один раз.
+ * Игнорируемые директории (.git, .gitignore, --exclude) не наблюдаются.
+ * Изменение .gitignore корня перечитывает правила и пересканирует дерево.
+ *
+ * Находки сравниваются как в baseline - по паттерну и тексту совпадения,
+ * без номера строки: сдвиг строк выше секрета не дает новой находки.
+ */
+class ScanWatcher {
+public:
+    static constexpr int DEFAULT_DEBOUNCE_MS = 200;
+
+    /**
+     * @param matcher Загруженные паттерны (должны жить дольше наблюдателя)
+     * @param options Опции сканирования (scan_path - директория)
+     * @param debounce_ms Пауза без событий, после которой пачка обрабатывается
+     */
+    ScanWatcher(const PatternMatcher& matcher, ScanOptions options,
+                int debounce_ms = DEFAULT_DEBOUNCE_MS);
+    ~ScanWatcher();
+
+    ScanWatcher(const ScanWatcher&) = delete;
+    ScanWatcher& operator=(const ScanWatcher&) = delete;
+
+    /**
+     * Подписаться на события и выполнить начальное сканирование
+     * @return false если путь не директория или inotify недоступен
+     */
+    bool start();
+
+    /**
+     * Дождаться пачки изменений и обновить набор находок
+     * @param timeout_ms Сколько ждать первого события
+     * @param update Изменения (заполняется, если были события)
+     * @return true если пачка обработана
+     */
+    bool waitForChanges(int timeout_ms, WatchUpdate& update);
+
+    /**
+     * Обрабатывать изменения до stop()
+     * @param on_update Вызывается для каждой пачки, изменившей набор находок
+     */
+    void run(const std::function<void(const WatchUpdate&)>& on_update);
+
+    /**
+     * Остановить run() (можно вызывать из обработчика сигнала)
+     */
+    void stop() { stopping.store(true, std::memory_order_relaxed); }
+
+    /**
+     * Текущий набор находок (по файлам в порядке пути)
+     */
+    std::vector<Match> currentMatches() const;
+
+    /**
+     * Статистика начального сканирования
+     */
+    const ScanStatistics& getInitialStatistics() const { return initial_statistics; }
+
+    /**
+     * Наблюдаемых директорий
+     */
+    size_t watchedDirectories() const { return watches.size(); }
+
+private:
+    const PatternMatcher& matcher;
+    ScanOptions options;
+    std::unique_ptr<FileScanner> scanner;   ///< Фильтры путей и сканирование отдельных файлов
+    int debounce_ms;
+    int inotify_fd = -1;
+    std::atomic<bool> stopping{false};
+    bool watch_limit_reported = false;
+
+    std::map<int, std::string> watches;                 ///< watch descriptor -> директория
+    std::map<std::string, std::vector<Match>> findings; ///< Живой набор: файл -> находки
+    ScanStatistics initial_statistics;
+
+    /**
+     * Директория не наблюдается: .git, .gitignore корня, --exclude
+     */
+    bool skipDirectory(const std::string& path);
+
+    /**
+     * Подписаться на директорию и (рекурсивно) поддиректории
+     * @param changed Сюда добавляются уже существующие файлы (для новой директории)
+     */
+    void watchTree(const std::string& directory, std::set<std::string>* changed);
+
+    /**
+     * Прочитать накопленные события
+     * @return false если очередь inotify переполнилась (нужно полное сканирование)
+     */
+    bool readEvents(std::set<std::string>& changed);
+
+    /**
+     * Пересканировать файлы и сравнить находки с предыдущими
+     */
+    void rescan(const std::set<std::string>& changed, WatchUpdate& update);
+
+    /**
+     * Полное сканирование (после переполнения очереди событий)
+     */
+    void rescanAll(WatchUpdate& update);
+
+    /**
+     * Пересоздать сканер с новыми правилами .gitignore и снять подписки
+     * с директорий, которые теперь игнорируются
+     */
+    void reloadIgnoreRules();
+
+    /**
+     * Заменить находки файла и дописать разницу в update
+     */
+    void replaceFindings(const std::string& file_path, std::vector<Match> matches, WatchUpdate& update);
+};
@@ -1,17 +1,29 @@
 #include "core/secret_detector.h"
 #include "core/file_scanner.h"
+#include "core/git_history_scanner.h"
+#include "core/pattern_bundle.h"
 #include "utils/logger.h"
 #include "utils/config_manager.h"
+#include "utils/file_utils.h"
 #include <chrono>
+#include <algorithm>
 
 bool SecretDetector::initialize(const std::string& patterns_config_path) {
     LOG_INFO("Initializing Secret Detector...");
 
-    // загрузить конфиг
-    json patterns_json = ConfigManager::loadJsonConfig(patterns_config_path);
+    // скомпилированный бандл рядом с конфигом: без разбора JSON и проверки стоимости regex
+    if (!patterns_config_path.empty() && FileUtils::fileExists(patterns_config_path) &&
+        PatternBundleReader::loadFresh(patterns_config_path, FileUtils::readFile(patterns_config_path),
+                                       matcher)) {
+        LOG_INFO_FMT("Loaded {} patterns", matcher.getPatternCount());
+        return true;
+    }
 
-    // загрузить паттерны
-    if (!matcher.loadFromJson(patterns_json)) {
+    // встроенные паттерны - готовая таблица, без JSON
+    bool loaded = patterns_config_path.empty()
+        ? matcher.loadBuiltin()
+        : matcher.loadFromJson(ConfigManager::loadJsonConfig(patterns_config_path));
+    if (!loaded) {
         LOG_ERROR("Failed to load patterns");
         return false;
     }
@@ -27,13 +39,20 @@ ScanResult SecretDetector::scan(const ScanOptions& options) {
     FileScanner scanner(options);
 
     // установить callback прогресса если нужно
-    if (progress_callback) {
-        scanner.setProgressCallback(progress_callback);
+    if (telemetry) {
+        scanner.setTelemetry(telemetry);
+    }
+    if (match_callback) {
+        scanner.setMatchCallback(match_callback);
     }
 
     // выполнить сканирование
+    matcher.resetProfile();
     result.matches = scanner.scan(matcher);
     result.statistics = scanner.getStatistics();
+    if (matcher.isProfiling()) {
+        result.pattern_profile = matcher.getProfile();
+    }
 
     // определить статус
     for (const auto& match : result.matches) {
@@ -46,3 +65,91 @@ ScanResult SecretDetector::scan(const ScanOptions& options) {
 
     return result;
 }
+
+ScanResult SecretDetector::scanStream(int fd, const std::string& source_name,
+                                      const ScanOptions& options,
+                                      std::function<void(const Match&)> on_match) {
+    ScanResult result;
+
+    FileScanner scanner(options);
+    if (telemetry) {
+        scanner.setTelemetry(telemetry);
+    }
+    matcher.resetProfile();
+    result.matches = scanner.scanStream(fd, source_name, matcher,
+                                        on_match ? on_match : match_callback);
+    result.statistics = scanner.getStatistics();
+    if (matcher.isProfiling()) {
+        result.pattern_profile = matcher.getProfile();
+    }
+
+    // находки могли не сохраниться - статус берем из статистики
+    result.has_critical = result.statistics.critical_count > 0;
+    result.has_high = result.statistics.high_count > 0;
+
+    return result;
+}
+
+ScanResult SecretDetector::scanGitHistory(const ScanOptions& options) {
+    ScanResult result;
+
+    GitHistoryScanner scanner(options);
+    if (match_callback) {
+        scanner.setMatchCallback(match_callback);
+    }
+    if (telemetry) {
+        scanner.setTelemetry(telemetry);
+    }
+    matcher.resetProfile();
+    result.matches = scanner.scan(matcher);
+    result.statistics = scanner.getStatistics();
+    if (matcher.isProfiling()) {
+        result.pattern_profile = matcher.getProfile();
+    }
+
+    for (const auto& match : result.matches) {
+        if (match.severity == "CRITICAL") {
+            result.has_critical = true;
+        } else if (match.severity == "HIGH") {
+            result.has_high = true;
+        }
+    }
+
+    return result;
+}
+
+ScanResult SecretDetector::scanBuffer(const char* data, size_t size, const std::string& name,
+                                      const ScanOptions& options) const {
+    auto start_time = std::chrono::steady_clock::now();
+    ScanResult result;
+    if (data == nullptr || size == 0) {
+        return result;
+    }
+
+    // regex работает по std::string - одна копия буфера
+    std::string content(data, size);
+    // отмена проверяется вместе с бюджетом, как в FileScanner
+    MatchBudget budget = options.file_budget;
+    budget.cancel = options.cancel.get();
+    MatchOutcome outcome;
+    result.matches = matcher.findMatches(content, name, budget, outcome);
+
+    auto& stats = result.statistics;
+    stats.total_files_scanned = 1;
+    stats.total_lines_scanned = std::count(content.begin(), content.end(), '\n') + 1;
+    stats.total_bytes_scanned = size;
+    stats.recordOutcome(name, outcome);
+    if (options.baseline) {
+        stats.baseline_suppressed = options.baseline->filter(result.matches, "");
+    }
+    stats.recordMatches(result.matches);
+    stats.scan_time_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    stats.match_time_seconds = stats.scan_time_seconds;
+    stats.threads_used = 1;
+    stats.cancelled = options.cancel && options.cancel->isCancelled();
+
+    result.has_critical = stats.critical_count > 0;
+    result.has_high = stats.high_count > 0;
+    return result;
+}
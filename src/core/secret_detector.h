@@ -15,6 +15,7 @@ using json = nlohmann::json;
 struct ScanResult {
     std::vector<Match> matches;
     ScanStatistics statistics;
+    std::vector<PatternProfile> pattern_profile;   ///< Профиль паттернов (--profile-patterns)
     bool has_critical = false;
     bool has_high = false;
 
@@ -43,6 +44,15 @@ nlohmann::json to_json() const {
         {"has_critical", has_critical},
         {"has_high", has_high}
     };
+    if (statistics.baseline_suppressed > 0) {
+        j["scan_summary"]["baseline_suppressed"] = statistics.baseline_suppressed;
+    }
+    if (!statistics.partial_files.empty()) {
+        j["scan_summary"]["partial_files"] = statistics.partial_files.size();
+    }
+    if (statistics.cancelled) {
+        j["scan_summary"]["cancelled"] = true;
+    }
 
     j["severity_breakdown"] = {
         {"critical", statistics.critical_count},
@@ -65,6 +75,9 @@ nlohmann::json to_json() const {
             if (match.entropy > 0) {
                 match_obj["entropy"] = match.entropy;
             }
+            if (!match.commit.empty()) {
+                match_obj["commit"] = match.commit;
+            }
             matches_array.push_back(match_obj);
         }
         j["results"] = matches_array;
@@ -80,6 +93,22 @@ nlohmann::json to_json() const {
             {"scan_time_seconds", statistics.scan_time_seconds},
             {"total_lines_scanned", statistics.total_lines_scanned}
         };
+        if (!pattern_profile.empty()) {
+            nlohmann::json profile_array = nlohmann::json::array();
+            for (const auto& entry : pattern_profile) {
+                profile_array.push_back(entry.to_json());
+            }
+            j["statistics"]["pattern_profile"] = profile_array;
+        }
+        if (!statistics.partial_files.empty()) {
+            nlohmann::json partial_array = nlohmann::json::array();
+            for (const auto& partial : statistics.partial_files) {
+                partial_array.push_back({{"file", partial.file_path},
+                                         {"cause", partialCauseName(partial.cause)},
+                                         {"reason", partial.reason}});
+            }
+            j["statistics"]["partial_files"] = partial_array;
+        }
 
         return j;
     }
@@ -97,7 +126,8 @@ public:
 
     /**
      * Инициализировать детектор с паттернами
-     * @param patterns_config_path Путь до patterns.json
+     * Если рядом лежит актуальный бандл (patterns.json.bundle), паттерны берутся из него.
+     * @param patterns_config_path Путь до patterns.json (пустой - встроенные паттерны)
      * @return true если успешно
      */
     bool initialize(const std::string& patterns_config_path);
@@ -110,13 +140,84 @@ public:
     ScanResult scan(const ScanOptions& options);
 
     /**
-     * Установить callback для прогресса
+     * Сканировать поток данных (stdin, pipe) без временных файлов
+     * @param fd Файловый дескриптор для чтения
+     * @param source_name Имя источника в отчете
+     * @param options Опции сканирования (используется baseline)
+     * @param on_match Callback для каждой находки по мере обнаружения
+     *                 (если задан - находки не накапливаются в ScanResult::matches)
+     * @return Результат сканирования
+     */
+    ScanResult scanStream(int fd, const std::string& source_name, const ScanOptions& options,
+                          std::function<void(const Match&)> on_match = nullptr);
+
+    /**
+     * Просканировать всю историю git-репозитория options.scan_path
+     * (каждый уникальный blob сканируется один раз)
+     * @param options Опции сканирования (используются фильтры путей)
+     * @return Результат сканирования
+     */
+    ScanResult scanGitHistory(const ScanOptions& options);
+
+    /**
+     * Просканировать буфер в памяти (без процесса и временных файлов)
+     * Потокобезопасен: один детектор можно использовать из нескольких
+     * потоков одновременно. Проверки на бинарность нет - что сканировать,
+     * решает вызывающий код.
+     * @param data Данные
+     * @param size Размер данных
+     * @param name Имя буфера в находках (file_path)
+     * @param options Опции (используются baseline и file_budget)
+     * @return Результат сканирования одного буфера
+     */
+    ScanResult scanBuffer(const char* data, size_t size, const std::string& name,
+                          const ScanOptions& options = ScanOptions()) const;
+
+    /**
+     * Получить загруженные паттерны (таблица правил для отчетов)
+     */
+    const std::vector<Pattern>& getPatterns() const { return matcher.getPatterns(); }
+
+    /**
+     * Получить загруженный PatternMatcher (сравнение движков)
+     */
+    const PatternMatcher& getMatcher() const { return matcher; }
+
+    /**
+     * Выбрать движок поиска совпадений
+     */
+    void setMatchEngine(MatchEngine engine) {
+        matcher.setEngine(engine);
+    }
+
+    /**
+     * Установить телеметрию прогресса
+     * Рабочие потоки только обновляют счетчики, отображение опрашивает их
+     * по таймеру (TelemetryReporter в CLI, QTimer в GUI).
+     */
+    void setTelemetry(std::shared_ptr<ScanTelemetry> scan_telemetry) {
+        telemetry = std::move(scan_telemetry);
+    }
+
+    /**
+     * Установить callback для находок
+     * Вызывается из рабочих потоков сразу после подтверждения находки,
+     * callback должен быть потокобезопасным.
+     */
+    void setMatchCallback(std::function<void(const Match&)> callback) {
+        match_callback = callback;
+    }
+
+    /**
+     * Включить профилирование паттернов
+     * Профиль каждого сканирования попадает в ScanResult::pattern_profile.
      */
-    void setProgressCallback(std::function<void(size_t, size_t)> callback) {
-        progress_callback = callback;
+    void setPatternProfiling(bool enable) {
+        matcher.enableProfiling(enable);
     }
 
 private:
     PatternMatcher matcher;
-    std::function<void(size_t, size_t)> progress_callback;
+    std::shared_ptr<ScanTelemetry> telemetry;
+    std::function<void(const Match&)> match_callback;
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "core/pattern_matcher.h"
+
+/**
+ * @struct WatchUpdate
+ * @brief Изменение набора находок после пачки событий файловой системы
+ */
+struct WatchUpdate {
+    std::vector<Match> added;       ///< Новые находки
+    std::vector<Match> removed;     ///< Исчезнувшие находки (файл исправлен или удален)
+    size_t files_rescanned = 0;     ///< Пересканировано файлов
+    size_t files_removed = 0;       ///< Удалено (или стало игнорируемым) файлов с находками
+    size_t total_findings = 0;      ///< Находок в наборе после изменения
+
+    bool empty() const { return added.empty() && removed.empty(); }
+};
@@ -43,6 +43,11 @@ MainWindow::MainWindow(QWidget *parent)
     createToolBar();
     createStatusBar();
     
+    // прогресс опрашивается по таймеру в UI потоке, сканер UI не вызывает
+    progressTimer = new QTimer(this);
+    progressTimer->setInterval(200);
+    connect(progressTimer, &QTimer::timeout, this, &MainWindow::onProgressTimer);
+    
     // попробовать несколько путей
     std::vector<std::string> config_paths = {
         "/opt/secret-detector/config/patterns.json"
@@ -65,7 +70,11 @@ MainWindow::MainWindow(QWidget *parent)
 }
 
 MainWindow::~MainWindow() {
-
+    // поток сканирования использует detector - дождаться, пока он выйдет из scan()
+    if (scanThread && scanThread->isRunning()) {
+        scanCancel->cancel();
+        scanThread->wait();
+    }
 }
 
 void MainWindow::setupUI() {
@@ -141,7 +150,7 @@ void MainWindow::setupUI() {
     connect(outputBrowseBtn, &QPushButton::clicked, this, &MainWindow::onOutputBrowseClicked);
     
     formatCombo = new QComboBox(this);
-    formatCombo->addItems({"Text", "JSON", "CSV", "HTML"});
+    formatCombo->addItems({"Text", "JSON", "SARIF", "Binary", "CSV", "HTML"});
     
     QComboBox* severityFilter = new QComboBox(this);
     severityFilter->addItems({"All", "CRITICAL", "HIGH", "MEDIUM", "LOW"});
@@ -226,6 +235,9 @@ void MainWindow::createMenuBar() {
     QAction* openAction = fileMenu->addAction("&Open Folder...");
     connect(openAction, &QAction::triggered, this, &MainWindow::onBrowseClicked);
     
+    QAction* openReportAction = fileMenu->addAction("Open &Report...");
+    connect(openReportAction, &QAction::triggered, this, &MainWindow::onOpenReportClicked);
+    
     QAction* exportAction = fileMenu->addAction("&Export Report...");
     connect(exportAction, &QAction::triggered, this, &MainWindow::onExportClicked);
     
@@ -385,40 +397,32 @@ void MainWindow::onScanClicked() {
     logText->append("[INFO] Starting scan...");
     statusBar()->showMessage("Scanning...");
     
-    scanThread = new ScanThread(&detector, options);
-    connect(scanThread, &ScanThread::progress, this, &MainWindow::onScanProgress);
+    scanTelemetry = std::make_shared<ScanTelemetry>();
+    telemetrySampler = std::make_unique<TelemetrySampler>(*scanTelemetry);
+    scanCancel = std::make_shared<CancellationToken>();
+    options.cancel = scanCancel;
+    
+    scanThread = new ScanThread(&detector, options, scanTelemetry);
     connect(scanThread, &ScanThread::finished, this, &MainWindow::onScanFinished);
     connect(scanThread, &ScanThread::error, this, &MainWindow::onScanError);
     connect(scanThread, &QThread::finished, scanThread, &QObject::deleteLater);
     
     scanThread->start();
+    progressTimer->start();
 }
 
 
 void MainWindow::onStopClicked() {
     if (scanThread && scanThread->isRunning()) {
-        disconnect(scanThread, nullptr, this, nullptr);
-        
-        scanThread->quit();
-        if (!scanThread->wait(1000)) {
-            scanThread->terminate();
-            scanThread->wait();
-        }
-        
-        logText->append("[WARNING] Scan stopped by user");
-        statusBar()->showMessage("Scan stopped");
+        // поток не убивается: scan() сам проверяет флаг и возвращает частичный
+        // результат, кнопки возвращает onScanFinished
+        scanCancel->cancel();
         
-        scanning = false;
-        scanBtn->setEnabled(true);
         stopBtn->setEnabled(false);
-        
-        // ВКЛЮЧИТЬ TOOLBAR КНОПКИ
-        toolbarScanAction->setEnabled(true);
         toolbarStopAction->setEnabled(false);
         
-        progressBar->setVisible(false);
-        
-        scanThread = nullptr;
+        logText->append("[WARNING] Stopping scan...");
+        statusBar()->showMessage("Stopping scan...");
     }
 }
 
@@ -428,12 +432,14 @@ void MainWindow::onClearClicked() {
     resultsTable->setRowCount(0);
     logText->clear();
     lastResult = ScanResult();
+    openReport.reset();
     statsLabel->setText("Ready");
     statusBar()->showMessage("Results cleared");
 }
 
 void MainWindow::onExportClicked() {
-    if (lastResult.matches.empty()) {
+    size_t resultCount = openReport ? openReport->size() : lastResult.matches.size();
+    if (resultCount == 0) {
         QMessageBox::information(this, "No Results", "No scan results to export.");
         return;
     }
@@ -445,6 +451,12 @@ void MainWindow::onExportClicked() {
     if (format == "json") {
         filter = "JSON Files (*.json)";
         defaultExt = ".json";
+    } else if (format == "sarif") {
+        filter = "SARIF Files (*.sarif)";
+        defaultExt = ".sarif";
+    } else if (format == "binary") {
+        filter = "Secret Detector Reports (*.sdr)";
+        defaultExt = ".sdr";
     } else if (format == "csv") {
         filter = "CSV Files (*.csv)";
         defaultExt = ".csv";
@@ -475,19 +487,32 @@ void MainWindow::onExportClicked() {
     
     try {
         std::string filePathStr = fileName.toStdString();
-        nlohmann::json data = lastResult.to_json();
+        
+        // открытый отчет разбирается целиком только здесь
+        ScanResult reportResult;
+        if (openReport) {
+            reportResult = openReport->toScanResult();
+        }
+        const ScanResult& result = openReport ? reportResult : lastResult;
         
         bool success = false;
         
         // экспорт в зависимости от формата (статические методы)
         if (format == "json") {
-            success = ExportManager::exportToJson(data, filePathStr);
-        } else if (format == "csv") {
-            success = ExportManager::exportToCsv(data, filePathStr);
-        } else if (format == "html") {
-            success = ExportManager::exportToHtml(data, filePathStr);
+            success = ExportManager::exportToJson(result, filePathStr);
+        } else if (format == "binary") {
+            success = ExportManager::exportToBinary(result, filePathStr);
+        } else if (format == "sarif") {
+            success = ExportManager::exportToSarif(result, detector.getPatterns(), filePathStr);
         } else {
-            success = ExportManager::exportToText(data, filePathStr);
+            nlohmann::json data = result.to_json();
+            if (format == "csv") {
+                success = ExportManager::exportToCsv(data, filePathStr);
+            } else if (format == "html") {
+                success = ExportManager::exportToHtml(data, filePathStr);
+            } else {
+                success = ExportManager::exportToText(data, filePathStr);
+            }
         }
         
         if (success) {
@@ -498,7 +523,7 @@ void MainWindow::onExportClicked() {
                 QString("Report exported to:\n%1\n\nFormat: %2\nMatches: %3")
                 .arg(fileName)
                 .arg(format.toUpper())
-                .arg(lastResult.matches.size()));
+                .arg(result.matches.size()));
         } else {
             throw std::runtime_error("Export failed");
         }
@@ -512,16 +537,64 @@ void MainWindow::onExportClicked() {
 
 
 
-void MainWindow::onScanProgress(int current, int total) {
-    int percent = (current * 100) / total;
-    progressBar->setValue(percent);
-    statusBar()->showMessage(QString("Scanning... %1/%2 files (%3%)")
-        .arg(current).arg(total).arg(percent));
+void MainWindow::onOpenReportClicked() {
+    if (scanning) {
+        return;
+    }
+    
+    QString fileName = QFileDialog::getOpenFileName(
+        this,
+        "Open Report",
+        QDir::homePath(),
+        "Secret Detector Reports (*.sdr)"
+    );
+    
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    // отчет читается через mmap: счетчики - из заголовка, в таблицу
+    // декодируются только первые строки, остальное - при экспорте
+    auto reader = std::make_unique<BinaryReportReader>();
+    if (!reader->open(fileName.toStdString())) {
+        QMessageBox::critical(this, "Open Report Failed",
+            QString("Cannot read report:\n%1").arg(fileName));
+        return;
+    }
+    
+    lastResult = ScanResult();
+    openReport = std::move(reader);
+    logText->append(QString("[INFO] Loaded report: %1 (%2 findings)")
+        .arg(fileName).arg(openReport->size()));
+    
+    loadReport(*openReport);
+    updateStatistics(openReport->getStatistics());
+    statusBar()->showMessage("Report loaded", 3000);
+}
+
+void MainWindow::onProgressTimer() {
+    if (!telemetrySampler) {
+        return;
+    }
+    
+    TelemetrySnapshot snap = telemetrySampler->sample();
+    progressBar->setValue(snap.percent());
+    
+    QString message = QString("Scanning... %1/%2 files (%3%) | %4 MB/s | %5 files/s")
+        .arg(snap.files_done).arg(snap.files_total).arg(snap.percent())
+        .arg(snap.bytes_per_second / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(static_cast<qlonglong>(snap.files_per_second));
+    if (snap.eta_seconds >= 0) {
+        message += QString(" | ETA %1s").arg(static_cast<qlonglong>(snap.eta_seconds + 0.5));
+    }
+    statusBar()->showMessage(message);
 }
 
 void MainWindow::onScanFinished(const ScanResult& result) {
     lastResult = result;
+    openReport.reset();
     scanning = false;
+    progressTimer->stop();
     
     // ВКЛЮЧИТЬ КНОПКИ ОБРАТНО
     scanBtn->setEnabled(true);
@@ -533,8 +606,13 @@ void MainWindow::onScanFinished(const ScanResult& result) {
     
     progressBar->setVisible(false);
     
-    logText->append(QString("[INFO] Scan completed in %1 seconds")
-        .arg(result.statistics.scan_time_seconds, 0, 'f', 2));
+    if (result.statistics.cancelled) {
+        logText->append(QString("[WARNING] Scan stopped by user after %1 files, results are partial")
+            .arg(result.statistics.total_files_scanned));
+    } else {
+        logText->append(QString("[INFO] Scan completed in %1 seconds")
+            .arg(result.statistics.scan_time_seconds, 0, 'f', 2));
+    }
     
     loadResults(result);
     updateStatistics(result.statistics);
@@ -542,6 +620,12 @@ void MainWindow::onScanFinished(const ScanResult& result) {
     // КРИТИЧЕСКИ ВАЖНО - ОБНУЛИТЬ УКАЗАТЕЛЬ
     scanThread = nullptr;
     
+    // остановлено пользователем - без уведомлений
+    if (result.statistics.cancelled) {
+        statusBar()->showMessage("Scan stopped");
+        return;
+    }
+    
     // показать уведомление
     if (result.has_critical) {
         QMessageBox::critical(this, "Critical Secrets Found",
@@ -559,6 +643,7 @@ void MainWindow::onScanFinished(const ScanResult& result) {
 
 void MainWindow::onScanError(const QString& error) {
     scanning = false;
+    progressTimer->stop();
     
     scanBtn->setEnabled(true);
     stopBtn->setEnabled(false);
@@ -574,57 +659,78 @@ void MainWindow::onScanError(const QString& error) {
     scanThread = nullptr;
 }
 
+namespace {
+    // ограничить до 1000 результатов для UI
+    constexpr size_t MAX_DISPLAY_ROWS = 1000;
+}
+
 void MainWindow::loadResults(const ScanResult& result) {
     resultsTable->setRowCount(0);
     
-    // ограничить до 1000 результатов для UI
-    size_t max_display = 1000;
-    size_t display_count = std::min(result.matches.size(), max_display);
+    size_t display_count = std::min(result.matches.size(), MAX_DISPLAY_ROWS);
+    warnTruncated(result.matches.size());
     
-    if (result.matches.size() > max_display) {
-        logText->append(QString("[WARNING] Too many results (%1). Showing first %2")
-            .arg(result.matches.size()).arg(max_display));
+    resultsTable->setUpdatesEnabled(false);  // отключить обновление для скорости
+    for (size_t i = 0; i < display_count; ++i) {
+        addResultRow(result.matches[i]);
     }
+    resultsTable->setUpdatesEnabled(true);  // включить обратно
+    resultsTable->resizeColumnsToContents();
+}
+
+void MainWindow::loadReport(const BinaryReportReader& reader) {
+    resultsTable->setRowCount(0);
     
-    resultsTable->setUpdatesEnabled(false);  // отключить обновление для скорости
+    // остальные находки остаются в mmap и не декодируются
+    size_t display_count = std::min(reader.size(), MAX_DISPLAY_ROWS);
+    warnTruncated(reader.size());
     
+    resultsTable->setUpdatesEnabled(false);
     for (size_t i = 0; i < display_count; ++i) {
-        const Match& match = result.matches[i];
-        
-        int row = resultsTable->rowCount();
-        resultsTable->insertRow(row);
-        
-        // безопасное создание items
-        auto fileItem = new QTableWidgetItem(QString::fromStdString(match.file_path));
-        auto lineItem = new QTableWidgetItem(QString::number(match.line_number));
-        auto severityItem = new QTableWidgetItem(QString::fromStdString(match.severity));
-        auto patternItem = new QTableWidgetItem(QString::fromStdString(match.pattern_name));
-        auto matchItem = new QTableWidgetItem(QString::fromStdString(match.matched_text));
-        auto previewItem = new QTableWidgetItem(QString::fromStdString(match.preview));
-        
-        // Цвет severity
-        if (match.severity == "CRITICAL") {
-            severityItem->setBackground(QColor(255, 200, 200));
-            severityItem->setForeground(QColor(139, 0, 0));
-        } else if (match.severity == "HIGH") {
-            severityItem->setBackground(QColor(255, 230, 200));
-            severityItem->setForeground(QColor(184, 92, 0));
-        } else if (match.severity == "MEDIUM") {
-            severityItem->setBackground(QColor(255, 255, 200));
-        }
-        
-        resultsTable->setItem(row, 0, fileItem);
-        resultsTable->setItem(row, 1, lineItem);
-        resultsTable->setItem(row, 2, severityItem);
-        resultsTable->setItem(row, 3, patternItem);
-        resultsTable->setItem(row, 4, matchItem);
-        resultsTable->setItem(row, 5, previewItem);
+        addResultRow(reader.getMatch(i));
     }
-    
-    resultsTable->setUpdatesEnabled(true);  // включить обратно
+    resultsTable->setUpdatesEnabled(true);
     resultsTable->resizeColumnsToContents();
 }
 
+void MainWindow::warnTruncated(size_t total) {
+    if (total > MAX_DISPLAY_ROWS) {
+        logText->append(QString("[WARNING] Too many results (%1). Showing first %2")
+            .arg(total).arg(MAX_DISPLAY_ROWS));
+    }
+}
+
+void MainWindow::addResultRow(const Match& match) {
+    int row = resultsTable->rowCount();
+    resultsTable->insertRow(row);
+    
+    // безопасное создание items
+    auto fileItem = new QTableWidgetItem(QString::fromStdString(match.file_path));
+    auto lineItem = new QTableWidgetItem(QString::number(match.line_number));
+    auto severityItem = new QTableWidgetItem(QString::fromStdString(match.severity));
+    auto patternItem = new QTableWidgetItem(QString::fromStdString(match.pattern_name));
+    auto matchItem = new QTableWidgetItem(QString::fromStdString(match.matched_text));
+    auto previewItem = new QTableWidgetItem(QString::fromStdString(match.preview));
+    
+    // Цвет severity
+    if (match.severity == "CRITICAL") {
+        severityItem->setBackground(QColor(255, 200, 200));
+        severityItem->setForeground(QColor(139, 0, 0));
+    } else if (match.severity == "HIGH") {
+        severityItem->setBackground(QColor(255, 230, 200));
+        severityItem->setForeground(QColor(184, 92, 0));
+    } else if (match.severity == "MEDIUM") {
+        severityItem->setBackground(QColor(255, 255, 200));
+    }
+    
+    resultsTable->setItem(row, 0, fileItem);
+    resultsTable->setItem(row, 1, lineItem);
+    resultsTable->setItem(row, 2, severityItem);
+    resultsTable->setItem(row, 3, patternItem);
+    resultsTable->setItem(row, 4, matchItem);
+    resultsTable->setItem(row, 5, previewItem);
+}
+
 
 void MainWindow::updateStatistics(const ScanStatistics& stats) {
     QString statsText = QString("Files: %1 | Matches: %2 (🔴 %3, 🟠 %4, 🟡 %5, 🟢 %6) | Time: %7s")
@@ -909,10 +1015,8 @@ void MainWindow::onResetEditorClicked() {
 
 void ScanThread::run() {
     try {
-        // Setup progress callback
-        detector->setProgressCallback([this](size_t current, size_t total) {
-            emit progress(current, total);
-        });
+        // только счетчики - MainWindow сам опрашивает их по таймеру
+        detector->setTelemetry(telemetry);
         
         ScanResult result = detector->scan(options);
         emit finished(result);
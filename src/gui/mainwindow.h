@@ -12,7 +12,10 @@
 #include <QLabel>
 #include <QThread>
 #include <QSettings>
+#include <QTimer>
+#include <memory>
 #include "core/secret_detector.h"
+#include "utils/binary_report.h"
 
 class ScanThread;
 
@@ -30,8 +33,9 @@ private slots:
     void onStopClicked();
     void onClearClicked();
     void onExportClicked();
+    void onOpenReportClicked();
 
-    void onScanProgress(int current, int total);
+    void onProgressTimer();
     void onScanFinished(const ScanResult& result);
     void onScanError(const QString& error);
     void onResultTableDoubleClicked(int row, int column);
@@ -45,6 +49,9 @@ private:
     void createStatusBar();
 
     void loadResults(const ScanResult& result);
+    void loadReport(const BinaryReportReader& reader);  // только первые строки, по индексу
+    void addResultRow(const Match& match);
+    void warnTruncated(size_t total);
     void updateStatistics(const ScanStatistics& stats);
 
     void openInEditor(const QString& filePath, int lineNumber);
@@ -86,7 +93,12 @@ private:
     // backend
     ScanThread* scanThread;
     SecretDetector detector;
+    std::shared_ptr<CancellationToken> scanCancel;      // отмена текущего сканирования (Stop)
+    std::shared_ptr<ScanTelemetry> scanTelemetry;       // счетчики текущего сканирования
+    std::unique_ptr<TelemetrySampler> telemetrySampler; // скорость и ETA для прогресса
+    QTimer* progressTimer;
     ScanResult lastResult;
+    std::unique_ptr<BinaryReportReader> openReport;     // открытый .sdr (mmap), разбирается только при экспорте
     bool scanning;
 
     QSettings* settings;
@@ -97,11 +109,11 @@ class ScanThread : public QThread {
     Q_OBJECT
 
 public:
-    ScanThread(SecretDetector* detector, const ScanOptions& options)
-        : detector(detector), options(options) {}
+    ScanThread(SecretDetector* detector, const ScanOptions& options,
+               std::shared_ptr<ScanTelemetry> telemetry)
+        : detector(detector), options(options), telemetry(std::move(telemetry)) {}
 
 signals:
-    void progress(int current, int total);
     void finished(const ScanResult& result);
     void error(const QString& error);
 
@@ -111,6 +123,7 @@ protected:
 private:
     SecretDetector* detector;
     ScanOptions options;
+    std::shared_ptr<ScanTelemetry> telemetry;
 
     // UI Components
     QLineEdit* pathEdit;
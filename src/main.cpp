@@ -2,10 +2,31 @@
 #include "core/secret_detector.h"
 #include "utils/logger.h"
 #include "utils/export_manager.h"
+#include "utils/json_report_writer.h"
+#include "utils/ndjson_writer.h"
+#include "utils/sarif_report_writer.h"
+#include "utils/binary_report.h"
+#include "utils/metrics_writer.h"
+#include "core/baseline.h"
+#include "core/engine_verifier.h"
+#include "core/scan_telemetry.h"
+#include "core/scan_server.h"
+#include "core/pattern_bundle.h"
+#include "core/scan_watcher.h"
+#include "core/cancellation.h"
 #include "utils/file_utils.h"
+#include "utils/trace_recorder.h"
 #include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
+#include <unistd.h>
+#include <csignal>
+#include <filesystem>
+#include <ctime>
 
 // цветной вывод
 const char* RED = "\033[1;31m";
@@ -14,68 +35,453 @@ const char* YELLOW = "\033[1;33m";
 const char* BLUE = "\033[1;34m";
 const char* RESET = "\033[0m";
 
-void printSummary(const ScanResult& result, bool strict_mode) {
-    std::cout << "\n" << BLUE << std::string(50, '=') << RESET << "\n";
-    std::cout << "\t\tSCAN SUMMARY\n";
-    std::cout << BLUE << std::string(50, '=') << RESET << "\n";
+void printMatchText(OutputSink& out, const Match& match) {
+    std::string line;
+    if (!match.commit.empty()) {
+        line += match.commit.substr(0, 12) + ":";
+    }
+    line += match.file_path + ":" + std::to_string(match.line_number) +
+            " [" + match.severity + "] " + match.pattern_name + "\n";
+    line += "  " + match.preview + "\n\n";
+    out.write(line);
+}
+
+void printMatchCsv(OutputSink& out, const Match& match) {
+    out.write("\"" + match.file_path + "\"," +
+              std::to_string(match.line_number) + "," +
+              std::to_string(match.column_number) + "," +
+              "\"" + match.pattern_name + "\"," +
+              "\"" + match.severity + "\"," +
+              "\"" + match.preview + "\"\n");
+}
+
+std::string formatBytes(double bytes) {
+    const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        unit++;
+    }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.1f %s", bytes, units[unit]);
+    return buf;
+}
+
+void printProgress(const TelemetrySnapshot& snap) {
+    std::string line = "Progress: " + std::to_string(snap.files_done);
+    if (snap.files_total > 0) {
+        line += "/" + std::to_string(snap.files_total) + " files (" +
+                std::to_string(snap.percent()) + "%)";
+    } else {
+        line += " files";
+    }
+    line += " | " + formatBytes(snap.bytes_per_second) + "/s";
+    line += " | " + std::to_string(static_cast<long long>(snap.files_per_second)) + " files/s";
+    if (snap.eta_seconds >= 0 && !snap.finished) {
+        line += " | ETA " + std::to_string(static_cast<long long>(snap.eta_seconds + 0.5)) + "s";
+    }
+    std::fprintf(stderr, "\r%-79s", line.c_str());
+}
+
+void printPatternProfile(OutputSink& out, const std::vector<PatternProfile>& profile) {
+    uint64_t total_ns = 0;
+    for (const auto& entry : profile) {
+        total_ns += entry.time_ns;
+    }
+
+    std::ostringstream table;
+    table << "\n" << BLUE << "PATTERN PROFILE (slowest first):" << RESET << "\n";
+    table << std::left << std::setw(28) << "Pattern" << std::right
+          << std::setw(12) << "Time, ms" << std::setw(8) << "Time %"
+          << std::setw(12) << "MB/s" << std::setw(12) << "Candidates"
+          << std::setw(11) << "Confirmed" << "\n";
+    table << std::fixed;
+    for (const auto& entry : profile) {
+        double ms = entry.time_ns / 1e6;
+        double share = total_ns > 0 ? 100.0 * entry.time_ns / total_ns : 0.0;
+        double mb_per_second = entry.time_ns > 0
+            ? (entry.bytes_examined / (1024.0 * 1024.0)) / (entry.time_ns / 1e9)
+            : 0.0;
+        table << std::left << std::setw(28) << entry.name << std::right
+              << std::setw(12) << std::setprecision(2) << ms
+              << std::setw(7) << std::setprecision(1) << share << "%"
+              << std::setw(12) << std::setprecision(1) << mb_per_second
+              << std::setw(12) << entry.candidates
+              << std::setw(11) << entry.confirmed << "\n";
+    }
+    table << "(time is summed over all worker threads; candidates are regex runs over a file or\n"
+          << " window that passed the prefilter, MB/s counts only the bytes given to the regex)\n";
+
+    out.write(table.str());
+}
+
+void printEngineVerification(OutputSink& out, const std::string& title,
+                             const EngineVerification& verification) {
+    // длинные списки различий обрезаются - для диагностики хватает первых
+    const size_t max_listed = 20;
+
+    std::ostringstream report;
+    report << title << ": " << verification.inputs << " inputs, "
+           << formatBytes(static_cast<double>(verification.bytes)) << ", "
+           << verification.reference_matches << " regex / "
+           << verification.candidate_matches << " candidate findings - "
+           << (verification.passed() ? std::string(GREEN) + "identical"
+                                     : std::string(RED) + std::to_string(verification.differences.size()) +
+                                       " differences")
+           << RESET << "\n";
+    for (size_t i = 0; i < verification.differences.size() && i < max_listed; ++i) {
+        const auto& difference = verification.differences[i];
+        report << "  only in " << difference.only_in << ": " << difference.file_path << ":"
+               << difference.line_number << ":" << difference.column_number << " "
+               << difference.pattern_name << " \"" << difference.matched_text << "\"\n";
+    }
+    if (verification.differences.size() > max_listed) {
+        report << "  ... " << verification.differences.size() - max_listed << " more\n";
+    }
+    out.write(report.str());
+}
+
+/**
+ * Сравнить находки движков: сканирование PATH каждым движком и сгенерированные входы
+ * @return 0 если находки совпадают, 1 если есть различия
+ */
+int verifyEngines(OutputSink& out, SecretDetector& detector, const ScanOptions& scan_options) {
+    const MatchEngine candidates[] = {MatchEngine::Prefilter};
+    const size_t fuzz_iterations = 5000;
+
+    detector.setMatchEngine(MatchEngine::Regex);
+    ScanResult reference = detector.scan(scan_options);
+
+    bool passed = true;
+    for (MatchEngine candidate : candidates) {
+        std::string name = EngineVerifier::engineName(candidate);
+        detector.setMatchEngine(candidate);
+        ScanResult result = detector.scan(scan_options);
+
+        EngineVerifier verifier(detector.getMatcher(), candidate);
+        EngineVerification corpus;
+        corpus.inputs = reference.statistics.total_files_scanned;
+        corpus.bytes = reference.statistics.total_bytes_scanned;
+        verifier.compareMatches(reference.matches, result.matches, corpus);
+        EngineVerification fuzz = verifier.verifyFuzz(1, fuzz_iterations);
+
+        out.write(std::string("\n") + BLUE + "ENGINE " + name + " vs regex:" + RESET + "\n");
+        printEngineVerification(out, "Scan", corpus);
+        printEngineVerification(out, "Generated", fuzz);
+        passed = passed && corpus.passed() && fuzz.passed();
+    }
+    detector.setMatchEngine(MatchEngine::Regex);
+
+    out.write(passed ? std::string(GREEN) + "\nENGINES AGREE" + RESET + "\n"
+                     : std::string(RED) + "\nENGINES DIFFER" + RESET + "\n");
+    return passed ? 0 : 1;
+}
+
+void printSummary(OutputSink& out, const ScanResult& result, bool strict_mode) {
+    std::ostringstream summary;
+    summary << "\n" << BLUE << std::string(50, '=') << RESET << "\n";
+    summary << "\t\tSCAN SUMMARY\n";
+    summary << BLUE << std::string(50, '=') << RESET << "\n";
 
     const auto& stats = result.statistics;
-    std::cout << "Files scanned:    " << stats.total_files_scanned << "\n";
-    std::cout << "Total lines:      " << stats.total_lines_scanned << "\n";
-    std::cout << "Total matches:    " << stats.total_matches_found << "\n";
+    summary << "Files scanned:    " << stats.total_files_scanned << "\n";
+    summary << "Total lines:      " << stats.total_lines_scanned << "\n";
+    summary << "Total matches:    " << stats.total_matches_found << "\n";
 
     if (stats.critical_count > 0) {
-        std::cout << RED << "  CRITICAL: " << stats.critical_count << RESET << "\n";
+        summary << RED << "  CRITICAL: " << stats.critical_count << RESET << "\n";
     } else {
-        std::cout << "  CRITICAL: " << stats.critical_count << "\n";
+        summary << "  CRITICAL: " << stats.critical_count << "\n";
     }
 
     if (stats.high_count > 0) {
-        std::cout << YELLOW << "  HIGH: " << stats.high_count << RESET << "\n";
+        summary << YELLOW << "  HIGH: " << stats.high_count << RESET << "\n";
     } else {
-        std::cout << "  HIGH: " << stats.high_count << "\n";
+        summary << "  HIGH: " << stats.high_count << "\n";
+    }
+
+    summary << "  MEDIUM: " << stats.medium_count << "\n";
+    summary << "  LOW: " << stats.low_count << "\n";
+
+    if (stats.baseline_suppressed > 0) {
+        summary << "Baseline:         " << stats.baseline_suppressed << " known findings suppressed\n";
+    }
+
+    if (!stats.partial_files.empty()) {
+        // окна из-за длинных строк (min.js и т.п.) - не превышение бюджета времени
+        const size_t windowed = stats.partialCount(PartialCause::LongLines);
+        const size_t over_budget = stats.partialCount(PartialCause::TimeBudget);
+        const size_t interrupted = stats.partialCount(PartialCause::Cancelled);
+        if (windowed > 0) {
+            summary << "Long lines:       " << windowed
+                    << " files scanned in windows (long lines)\n";
+        }
+        if (over_budget > 0) {
+            summary << YELLOW << "Partial scans:    " << over_budget
+                    << " files exceeded the per-file time budget" << RESET << "\n";
+        }
+        if (interrupted > 0) {
+            summary << YELLOW << "Interrupted:      " << interrupted
+                    << " files not fully scanned before cancellation" << RESET << "\n";
+        }
+        // полный список - в отчете, здесь только первые
+        const size_t shown = std::min<size_t>(stats.partial_files.size(), 5);
+        for (size_t i = 0; i < shown; ++i) {
+            summary << "  " << stats.partial_files[i].file_path << ": "
+                    << stats.partial_files[i].reason << "\n";
+        }
+        if (stats.partial_files.size() > shown) {
+            summary << "  ... and " << (stats.partial_files.size() - shown) << " more\n";
+        }
     }
 
-    std::cout << "  MEDIUM: " << stats.medium_count << "\n";
-    std::cout << "  LOW: " << stats.low_count << "\n";
+    if (stats.cancelled) {
+        summary << YELLOW << "Cancelled:        scan interrupted, results are partial" << RESET << "\n";
+    }
 
-    std::cout << "Scan time:        " << std::fixed << std::setprecision(2) 
-              << stats.scan_time_seconds << "s\n";
+    summary << "Scan time:        " << std::fixed << std::setprecision(2) 
+            << stats.scan_time_seconds << "s\n";
 
-    std::cout << "\n" << BLUE << std::string(50, '=') << RESET << "\n";
+    summary << "\n" << BLUE << std::string(50, '=') << RESET << "\n";
 
     // код выхода
     int exit_code = 0;
     if (result.has_critical || (strict_mode && result.statistics.total_matches_found > 0)) {
-        std::cout << RED << "SCAN FAILED: Secrets detected!" << RESET << "\n";
+        summary << RED << "SCAN FAILED: Secrets detected!" << RESET << "\n";
         exit_code = 1;
     } else if (result.has_high) {
-        std::cout << YELLOW << "WARNING: High severity matches found" << RESET << "\n";
+        summary << YELLOW << "WARNING: High severity matches found" << RESET << "\n";
         exit_code = 0; // Don't fail, just warn
     } else if (result.statistics.total_matches_found > 0) {
-        std::cout << YELLOW << "Info: Some matches found (LOW/MEDIUM severity)" << RESET << "\n";
+        summary << YELLOW << "Info: Some matches found (LOW/MEDIUM severity)" << RESET << "\n";
         exit_code = 0;
     } else {
-        std::cout << GREEN << "SCAN PASSED: No secrets detected!" << RESET << "\n";
+        summary << GREEN << "SCAN PASSED: No secrets detected!" << RESET << "\n";
         exit_code = 0;
     }
 
-    std::cout << "\n";
+    summary << "\n";
 
     // топ находок
     if (!result.matches.empty()) {
-        std::cout << BLUE << "TOP FINDINGS (max 10):" << RESET << "\n";
+        summary << BLUE << "TOP FINDINGS (max 10):" << RESET << "\n";
         int count = 0;
         for (const auto& match : result.matches) {
             if (count >= 10) break;
             if (match.severity == "CRITICAL" || match.severity == "HIGH") {
-                std::cout << "  [" << match.severity << "] "
-                         << match.file_path << ":" << match.line_number
-                         << " - " << match.pattern_name << "\n";
+                summary << "  [" << match.severity << "] "
+                        << match.file_path << ":" << match.line_number
+                        << " - " << match.pattern_name << "\n";
                 count++;
             }
         }
     }
+
+    out.write(summary.str());
+}
+
+// сервер, который останавливают SIGINT/SIGTERM
+ScanServer* active_server = nullptr;
+
+void stopServer(int) {
+    if (active_server) {
+        active_server->stop();
+    }
+}
+
+// сканирование, которое отменяют SIGINT/SIGTERM
+CancellationToken* active_scan = nullptr;
+
+void cancelScan(int) {
+    if (active_scan) {
+        active_scan->cancel();
+    }
+}
+
+/**
+ * Отменять сканирование по SIGINT/SIGTERM вместо завершения процесса
+ * Без SA_RESTART: блокирующий read() из stdin возвращает EINTR.
+ * SA_RESETHAND: повторный Ctrl+C завершает процесс сразу.
+ */
+void installCancelHandler(CancellationToken& token) {
+    active_scan = &token;
+    struct sigaction action{};
+    action.sa_handler = cancelScan;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+
+// наблюдение, которое останавливают SIGINT/SIGTERM
+ScanWatcher* active_watcher = nullptr;
+
+void stopWatcher(int) {
+    if (active_watcher) {
+        active_watcher->stop();
+    }
+}
+
+void printWatchUpdate(OutputSink& out, const WatchUpdate& update) {
+    char stamp[16];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%H:%M:%S", std::localtime(&now));
+
+    std::ostringstream text;
+    text << BLUE << "[" << stamp << "]" << RESET << " "
+         << update.added.size() << " new, " << update.removed.size() << " resolved ("
+         << update.files_rescanned << " files rescanned, " << update.total_findings
+         << " findings total)\n";
+    for (const auto& match : update.added) {
+        text << RED << "  + " << RESET << match.file_path << ":" << match.line_number
+             << " [" << match.severity << "] " << match.pattern_name << "\n"
+             << "      " << match.preview << "\n";
+    }
+    for (const auto& match : update.removed) {
+        text << GREEN << "  - " << RESET << match.file_path << ":" << match.line_number
+             << " [" << match.severity << "] " << match.pattern_name << "\n";
+    }
+    text << "\n";
+    out.write(text.str());
+}
+
+/**
+ * Начальное сканирование и наблюдение за изменениями до Ctrl+C
+ */
+int runWatch(const CLIOptions& options, const SecretDetector& detector, const ScanOptions& scan_options) {
+    ScanWatcher watcher(detector.getMatcher(), scan_options);
+    if (!watcher.start()) {
+        return 1;
+    }
+
+    AsyncSink console(std::make_unique<FileSink>(stdout));
+    std::unique_ptr<NdjsonWriter> ndjson;
+    if (options.format == "ndjson") {
+        ndjson = std::make_unique<NdjsonWriter>(console);
+    }
+
+    ScanResult initial;
+    initial.matches = watcher.currentMatches();
+    initial.statistics = watcher.getInitialStatistics();
+    initial.has_critical = initial.statistics.critical_count > 0;
+    initial.has_high = initial.statistics.high_count > 0;
+    if (ndjson) {
+        for (const auto& match : initial.matches) {
+            ndjson->writeFinding(match);
+        }
+        ndjson->writeSummary(initial.statistics, initial.has_critical, initial.has_high);
+    } else {
+        for (const auto& match : initial.matches) {
+            printMatchText(console, match);
+        }
+        printSummary(console, initial, options.strict);
+    }
+    console.flush();
+
+    LOG_INFO_FMT("Watching {} for changes (Ctrl+C to stop)", scan_options.scan_path);
+    active_watcher = &watcher;
+    std::signal(SIGINT, stopWatcher);
+    std::signal(SIGTERM, stopWatcher);
+
+    watcher.run([&](const WatchUpdate& update) {
+        if (ndjson) {
+            for (const auto& match : update.added) {
+                ndjson->writeFinding(match);
+            }
+            for (const auto& match : update.removed) {
+                ndjson->writeResolved(match);
+            }
+            ndjson->writeUpdate(update);
+        } else {
+            printWatchUpdate(console, update);
+        }
+        console.flush();
+    });
+
+    active_watcher = nullptr;
+    console.close();
+    return 0;
+}
+
+/**
+ * Отправить сканирование резидентному серверу и вывести ответ
+ * Паттерны здесь не загружаются - запуск клиента ничего не стоит.
+ */
+int runClient(const CLIOptions& options) {
+    json request;
+    if (options.read_stdin) {
+        std::string data((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        request = {{"type", "scan_buffer"}, {"name", options.stdin_name}, {"data", std::move(data)}};
+    } else {
+        std::error_code ec;
+        std::string path = std::filesystem::absolute(options.scan_path, ec).string();
+        request = {{"type", "scan"}, {"path", ec ? options.scan_path : path},
+                   {"recursive", options.recursive}, {"gitignore", options.respect_gitignore},
+                   {"exclude", options.exclude_patterns}, {"include_ext", options.include_extensions}};
+    }
+
+    ScanClient client(options.client_socket);
+    if (!client.connect()) {
+        LOG_ERROR_FMT("No server is listening on {}", options.client_socket);
+        return 2;
+    }
+
+    AsyncSink console(std::make_unique<FileSink>(stdout));
+    ScanResult result;
+    std::string error;
+    bool answered = client.request(request, [&](const std::string& line, const json& message) {
+        std::string type = message.value("type", "");
+        if (options.format == "ndjson" && type != "error") {
+            console.write(line + "\n");
+            console.flush();
+            return;
+        }
+
+        if (type == "finding") {
+            Match match;
+            match.file_path = message.value("file_path", "");
+            match.line_number = message.value("line_number", 0);
+            match.column_number = message.value("column_number", 0);
+            match.severity = message.value("severity", "");
+            match.pattern_name = message.value("pattern_name", "");
+            match.matched_text = message.value("matched_text", "");
+            match.preview = message.value("preview", "");
+            printMatchText(console, match);
+            console.flush();
+            result.matches.push_back(std::move(match));
+        } else if (type == "summary") {
+            ScanStatistics& stats = result.statistics;
+            stats.total_files_scanned = message.value("total_files", 0);
+            stats.total_lines_scanned = message.value("total_lines", 0);
+            stats.total_matches_found = message.value("total_matches", 0);
+            stats.critical_count = message.value("critical", 0);
+            stats.high_count = message.value("high", 0);
+            stats.medium_count = message.value("medium", 0);
+            stats.low_count = message.value("low", 0);
+            stats.baseline_suppressed = message.value("baseline_suppressed", 0);
+            stats.scan_time_seconds = message.value("scan_time_seconds", 0.0);
+            result.has_critical = message.value("has_critical", false);
+            result.has_high = message.value("has_high", false);
+        } else if (type == "error") {
+            error = message.value("message", "");
+        }
+    });
+
+    if (!answered) {
+        console.close();
+        LOG_ERROR_FMT("Scan request failed: {}", error.empty() ? "connection closed" : error);
+        return 2;
+    }
+
+    if (options.format == "text") {
+        printSummary(console, result, options.strict);
+    }
+    console.close();
+
+    if (result.has_critical || (options.strict && result.statistics.total_matches_found > 0)) {
+        return 1;
+    }
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
@@ -111,8 +517,20 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (!options.client_socket.empty()) {
+        return runClient(options);
+    }
+
+    // временная шкала: включается до загрузки паттернов, чтобы попала и она
+    if (!options.trace_path.empty()) {
+        TraceRecorder::start();
+    }
+
     // сам детектор
     SecretDetector detector;
+    detector.setPatternProfiling(options.profile_patterns);
+    detector.setMatchEngine(options.engine == "prefilter" ? MatchEngine::Prefilter
+                                                          : MatchEngine::Regex);
 
     std::string config_path = options.config_path.empty() 
         ? "/etc/secret_detector/patterns.json" 
@@ -137,7 +555,24 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    if (!detector.initialize(config_path)) {
+    // компиляция бандла: детектор не нужен
+    if (options.compile_patterns) {
+        if (config_path.empty()) {
+            LOG_ERROR("No patterns config to compile (pass --config)");
+            return 1;
+        }
+        std::string bundle_path = options.output_path.empty()
+            ? PatternBundle::defaultPath(config_path)
+            : options.output_path;
+        return PatternBundleWriter::compile(config_path, bundle_path) ? 0 : 1;
+    }
+
+    bool initialized;
+    {
+        TRACE_SCOPE("load patterns", "setup");
+        initialized = detector.initialize(config_path);
+    }
+    if (!initialized) {
         LOG_ERROR("Failed to initialize detector");
         return 1;
     }
@@ -147,38 +582,218 @@ int main(int argc, char* argv[]) {
     scan_options.scan_path = options.scan_path;
     scan_options.recursive = options.recursive;
     scan_options.respect_gitignore = options.respect_gitignore;
+    scan_options.deduplicate_content = options.deduplicate;
     scan_options.num_threads = options.num_threads;
     scan_options.exclude_patterns = options.exclude_patterns;
     scan_options.include_extensions = options.include_extensions;
+    scan_options.file_budget.time_ms = options.file_budget_ms;
+    scan_options.file_budget.max_line_length = static_cast<size_t>(options.max_line_length);
+
+    // baseline: известные находки отфильтровываются прямо в сканере
+    // (при обновлении baseline нужны все текущие находки)
+    if (!options.baseline_path.empty() && options.update_baseline_path.empty()) {
+        auto baseline = std::make_shared<Baseline>();
+        if (!baseline->load(options.baseline_path)) {
+            return 1;
+        }
+        scan_options.baseline = baseline;
+    }
 
-    // прогресс сканирования
-    detector.setProgressCallback([](size_t current, size_t total) {
-        int percent = (current * 100) / total;
-        std::cout << "\rProgress: " << current << "/" << total 
-                 << " (" << percent << "%)" << std::flush;
-    });
+    if (!options.serve_socket.empty()) {
+        ScanServer server(detector, scan_options, options.serve_socket);
+        if (!server.start()) {
+            return 1;
+        }
+        active_server = &server;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        server.run();
+        active_server = nullptr;
+        return 0;
+    }
+
+    if (options.watch) {
+        return runWatch(options, detector, scan_options);
+    }
+
+    ScanResult result;
+
+    // весь вывод в консоль идет через один приемник с отдельным потоком записи
+    AsyncSink console(std::make_unique<FileSink>(stdout));
+
+    if (options.verify_engines) {
+        return verifyEngines(console, detector, scan_options);
+    }
+
+    // машиночитаемый отчет в stdout - сводка его не должна портить
+    bool report_to_stdout = options.output_path.empty() &&
+        (options.format == "json" || options.format == "ndjson" || options.format == "sarif");
+
+    // ndjson: находки пишутся построчно сразу после подтверждения
+    std::unique_ptr<AsyncSink> ndjson_file;
+    std::unique_ptr<NdjsonWriter> ndjson_writer;
+    if (options.format == "ndjson") {
+        OutputSink* ndjson_sink = &console;
+        if (!options.output_path.empty()) {
+            auto file = FileSink::open(options.output_path);
+            if (!file) {
+                LOG_ERROR_FMT("Cannot open output file: {}", options.output_path);
+                return 1;
+            }
+            ndjson_file = std::make_unique<AsyncSink>(std::move(file));
+            ndjson_sink = ndjson_file.get();
+        }
+        ndjson_writer = std::make_unique<NdjsonWriter>(*ndjson_sink);
+        NdjsonWriter* writer = ndjson_writer.get();
+        detector.setMatchCallback([writer](const Match& match) {
+            writer->writeFinding(match);
+        });
+    }
+
+    // Ctrl+C останавливает сканирование, найденное до этого выводится как обычно
+    auto cancel = std::make_shared<CancellationToken>();
+    scan_options.cancel = cancel;
+
+    if (!options.read_report.empty()) {
+        // готовый бинарный отчет: выборка через mmap, без сканирования
+        BinaryReportReader reader;
+        if (!reader.open(options.read_report)) {
+            return 1;
+        }
+
+        BinaryReportFilter filter;
+        filter.severity = options.filter_severity;
+        filter.pattern_name = options.filter_pattern;
+        filter.path_prefix = options.filter_path;
+        result = reader.toScanResult(filter);
+        LOG_INFO_FMT("Loaded {} of {} findings from {}",
+                     result.matches.size(), reader.size(), options.read_report);
+
+        if (ndjson_writer) {
+            for (const auto& match : result.matches) {
+                ndjson_writer->writeFinding(match);
+            }
+        }
+    } else if (options.read_stdin) {
+        // потоковый режим: находки уходят в консоль сразу по мере обнаружения
+        std::function<void(const Match&)> on_match;
+        JsonReportWriter json_report(console);
+        SarifReportWriter sarif_report(console, detector.getPatterns());
+        if (options.output_path.empty() && options.format == "sarif") {
+            sarif_report.begin();
+            on_match = [&sarif_report, &console](const Match& match) {
+                sarif_report.writeMatch(match);
+                console.flush();
+            };
+        } else if (options.output_path.empty() && options.format == "json") {
+            // results идут первыми в схеме отчета - находки пишутся сразу
+            json_report.begin();
+            on_match = [&json_report, &console](const Match& match) {
+                json_report.writeMatch(match);
+                console.flush();
+            };
+        } else if (options.output_path.empty() && options.format == "text") {
+            on_match = [&console](const Match& match) {
+                printMatchText(console, match);
+                console.flush();
+            };
+        } else if (options.output_path.empty() && options.format == "csv") {
+            console.write("File,Line,Column,Pattern,Severity,Preview\n");
+            on_match = [&console](const Match& match) {
+                printMatchCsv(console, match);
+                console.flush();
+            };
+        }
+
+        LOG_INFO("Starting stdin scan...");
+        installCancelHandler(*cancel);
+        result = detector.scanStream(STDIN_FILENO, options.stdin_name, scan_options, on_match);
+
+        if (options.output_path.empty() && options.format == "json") {
+            json_report.finish(result.statistics, result.has_critical, result.has_high,
+                               result.pattern_profile);
+        } else if (options.output_path.empty() && options.format == "sarif") {
+            sarif_report.finish(result.statistics);
+        }
+    } else {
+        // прогресс: рабочие потоки только считают, строку рисует отдельный поток
+        // репортера - в терминал (stderr) и не чаще 10 раз в секунду
+        auto telemetry = std::make_shared<ScanTelemetry>();
+        std::unique_ptr<TelemetryReporter> reporter;
+        if (isatty(STDERR_FILENO)) {
+            detector.setTelemetry(telemetry);
+            reporter = std::make_unique<TelemetryReporter>(
+                *telemetry, std::chrono::milliseconds(100), printProgress);
+        }
+
+        // начало сканирования
+        installCancelHandler(*cancel);
+        if (options.git_history) {
+            LOG_INFO("Starting git history scan...");
+            result = detector.scanGitHistory(scan_options);
+        } else {
+            LOG_INFO("Starting scan...");
+            result = detector.scan(scan_options);
+        }
+
+        if (reporter) {
+            reporter->stop();
+            std::fprintf(stderr, "\r%s\r", std::string(79, ' ').c_str()); // очистка линии прогресса
+        }
+    }
 
-    // начало сканирования
-    LOG_INFO("Starting scan...");
-    ScanResult result = detector.scan(scan_options);
+    if (result.statistics.cancelled) {
+        LOG_WARN("Scan was cancelled, reporting partial results");
+    }
 
-    std::cout << "\r" << std::string(50, ' ') << "\r"; // очистка линии прогресса
+    // запись baseline: все текущие находки становятся известными
+    if (!options.update_baseline_path.empty() && result.statistics.cancelled) {
+        LOG_ERROR("Baseline not written: the scan was cancelled before it finished");
+    } else if (!options.update_baseline_path.empty()) {
+        std::string root = options.git_history ? "" : scan_options.scan_path;
+        if (!Baseline::save(result.matches, root, options.update_baseline_path)) {
+            LOG_ERROR("Failed to write baseline");
+            return 1;
+        }
+    }
+
+    if (ndjson_writer) {
+        ndjson_writer->writeSummary(result.statistics, result.has_critical, result.has_high);
+        if (ndjson_file) {
+            ndjson_file->close();
+            if (ndjson_file->failed()) {
+                LOG_ERROR("Failed to write ndjson output");
+                return 1;
+            }
+        }
+    }
 
     // экспорт отчета
-    if (!options.output_path.empty()) {
+    auto export_start = std::chrono::steady_clock::now();
+    uint64_t trace_export_start = TraceRecorder::enabled() ? TraceRecorder::now() : 0;
+    if (options.format == "ndjson") {
+        // уже записано по мере сканирования
+    } else if (!options.output_path.empty()) {
         LOG_INFO_FMT("Exporting results to: {}", options.output_path);
 
         bool export_success = false;
-        json output = result.to_json();
 
         if (options.format == "json") {
-            export_success = ExportManager::exportToJson(output, options.output_path);
-        } else if (options.format == "csv") {
-            export_success = ExportManager::exportToCsv(output, options.output_path);
-        } else if (options.format == "html") {
-            export_success = ExportManager::exportToHtml(output, options.output_path);
-        } else if (options.format == "text") {
-            export_success = ExportManager::exportToText(output, options.output_path);
+            export_success = ExportManager::exportToJson(result, options.output_path);
+        } else if (options.format == "binary") {
+            export_success = ExportManager::exportToBinary(result, options.output_path);
+        } else if (options.format == "sarif") {
+            export_success = ExportManager::exportToSarif(result, detector.getPatterns(),
+                                                          options.output_path);
+        } else {
+            json output = result.to_json();
+            if (options.format == "csv") {
+                export_success = ExportManager::exportToCsv(output, options.output_path);
+            } else if (options.format == "html") {
+                export_success = ExportManager::exportToHtml(output, options.output_path);
+            } else if (options.format == "text") {
+                export_success = ExportManager::exportToText(output, options.output_path);
+            }
         }
 
         if (!export_success) {
@@ -188,36 +803,77 @@ int main(int argc, char* argv[]) {
     } else {
         // печатаем в консоль
         if (options.format == "json") {
-            std::cout << result.to_json().dump(2) << "\n";
+            if (!options.read_stdin) {
+                JsonReportWriter::write(result, console);
+            }
+        } else if (options.format == "sarif") {
+            if (!options.read_stdin) {
+                SarifReportWriter::write(result, detector.getPatterns(), console);
+            }
         } else if (options.format == "csv") {
-            std::cout << "File,Line,Column,Pattern,Severity,Preview\n";
+            if (!options.read_stdin) {
+                console.write("File,Line,Column,Pattern,Severity,Preview\n");
+            }
             for (const auto& match : result.matches) {
-                std::cout << "\"" << match.file_path << "\","
-                         << match.line_number << ","
-                         << match.column_number << ","
-                         << "\"" << match.pattern_name << "\","
-                         << "\"" << match.severity << "\","
-                         << "\"" << match.preview << "\"\n";
+                printMatchCsv(console, match);
             }
         } else {
             // текстовый формат по умолчанию
             if (!result.matches.empty()) {
-                std::cout << "\nMatches found:\n";
+                console.write("\nMatches found:\n");
                 for (const auto& match : result.matches) {
-                    std::cout << match.file_path << ":"
-                             << match.line_number << " ["
-                             << match.severity << "] "
-                             << match.pattern_name << "\n";
-                    std::cout << "  " << match.preview << "\n\n";
+                    printMatchText(console, match);
                 }
             }
         }
     }
 
+    result.statistics.export_time_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - export_start).count();
+    if (TraceRecorder::enabled()) {
+        TraceRecorder::record("export", "report", trace_export_start, TraceRecorder::now(), &options.format);
+    }
+
+    // рабочие потоки завершены - буферы трассировки можно сбросить
+    if (!options.trace_path.empty() && !TraceRecorder::writeFile(options.trace_path)) {
+        return 1;
+    }
+
+    // метрики пишутся после экспорта: в них входит его длительность
+    if (!options.metrics_path.empty()) {
+        result.statistics.recordPeakRss();
+        if (!MetricsWriter::writeTextfile(result.statistics, options.metrics_path)) {
+            LOG_ERROR("Failed to write metrics");
+            return 1;
+        }
+    }
+
     // заключение
-    printSummary(result, options.strict);
+    if (!report_to_stdout) {
+        printSummary(console, result, options.strict);
+    }
 
-    // код возврата
+    // профиль паттернов: в stdout только если там не машиночитаемый отчет
+    if (!result.pattern_profile.empty()) {
+        if (report_to_stdout) {
+            console.flush();
+            FileSink err(stderr);
+            printPatternProfile(err, result.pattern_profile);
+        } else {
+            printPatternProfile(console, result.pattern_profile);
+        }
+    }
+    console.close();
+
+    // прерванное сканирование не проходит проверку: 128 + SIGINT, как у shell
+    if (result.statistics.cancelled) {
+        return 130;
+    }
+
+    // код возврата (обновление baseline - это принятие находок, а не проверка)
+    if (!options.update_baseline_path.empty()) {
+        return 0;
+    }
     if (result.has_critical) {
         return 1;
     } else if (options.strict && result.statistics.total_matches_found > 0) {
@@ -0,0 +1,369 @@
+#include "utils/binary_report.h"
+#include "utils/logger.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace BinaryReport;
+
+namespace {
+    uint64_t align8(uint64_t value) {
+        return (value + 7) & ~uint64_t(7);
+    }
+
+    // размер одного значения колонки
+    size_t columnWidth(int column) {
+        return column == COL_ENTROPY ? sizeof(double) : sizeof(uint32_t);
+    }
+
+    // отметить строки таблицы, подходящие под условие
+    std::vector<bool> markStrings(const BinaryReportReader& reader, uint64_t count,
+                                  const std::function<bool(const std::string&)>& predicate) {
+        std::vector<bool> marks(count, false);
+        for (uint64_t id = 0; id < count; ++id) {
+            marks[id] = predicate(reader.getString(static_cast<uint32_t>(id)));
+        }
+        return marks;
+    }
+}
+
+// ============================================================================
+// BinaryReportWriter
+// ============================================================================
+
+BinaryReportWriter::BinaryReportWriter(OutputSink& s) : sink(s) {}
+
+uint32_t BinaryReportWriter::intern(const std::string& str) {
+    auto [it, inserted] = string_ids.emplace(str, static_cast<uint32_t>(strings.size()));
+    if (inserted) {
+        strings.push_back(str);
+        string_bytes += str.size();
+    }
+    return it->second;
+}
+
+void BinaryReportWriter::writeMatch(const Match& match) {
+    string_columns[COL_PATH].push_back(intern(match.file_path));
+    string_columns[COL_PATTERN].push_back(intern(match.pattern_name));
+    string_columns[COL_SEVERITY].push_back(intern(match.severity));
+    string_columns[COL_MATCHED_TEXT].push_back(intern(match.matched_text));
+    string_columns[COL_PREVIEW].push_back(intern(match.preview));
+    string_columns[COL_COMMIT].push_back(match.commit.empty() ? NO_STRING : intern(match.commit));
+    lines.push_back(match.line_number);
+    columns.push_back(match.column_number);
+    entropies.push_back(match.entropy);
+}
+
+void BinaryReportWriter::writePadding(uint64_t written) {
+    static const char zeros[8] = {0};
+    uint64_t padding = align8(written) - written;
+    if (padding > 0) {
+        sink.write(zeros, padding);
+    }
+}
+
+void BinaryReportWriter::finish(const ScanStatistics& statistics) {
+    const uint64_t count = lines.size();
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.finding_count = count;
+    header.string_count = strings.size();
+
+    // раскладка секций
+    uint64_t offset = sizeof(Header);
+    header.string_offsets_offset = offset;
+    offset += (strings.size() + 1) * sizeof(uint64_t);
+    header.string_data_offset = offset;
+    offset = align8(offset + string_bytes);
+    for (int column = 0; column < COLUMN_COUNT; ++column) {
+        header.column_offsets[column] = offset;
+        offset = align8(offset + count * columnWidth(column));
+    }
+
+    header.total_files_scanned = statistics.total_files_scanned;
+    header.total_lines_scanned = statistics.total_lines_scanned;
+    header.total_matches_found = statistics.total_matches_found;
+    header.critical_count = statistics.critical_count;
+    header.high_count = statistics.high_count;
+    header.medium_count = statistics.medium_count;
+    header.low_count = statistics.low_count;
+    header.duplicate_files = statistics.duplicate_files;
+    header.scan_time_seconds = statistics.scan_time_seconds;
+    header.baseline_suppressed = statistics.baseline_suppressed;
+
+    sink.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // таблица строк
+    std::vector<uint64_t> offsets;
+    offsets.reserve(strings.size() + 1);
+    uint64_t position = 0;
+    for (const auto& str : strings) {
+        offsets.push_back(position);
+        position += str.size();
+    }
+    offsets.push_back(position);
+    sink.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+
+    for (const auto& str : strings) {
+        sink.write(str);
+    }
+    writePadding(string_bytes);
+
+    // колонки
+    for (int column = 0; column < COL_LINE; ++column) {
+        const auto& values = string_columns[column];
+        sink.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(uint32_t));
+        writePadding(values.size() * sizeof(uint32_t));
+    }
+    sink.write(reinterpret_cast<const char*>(lines.data()), lines.size() * sizeof(int32_t));
+    writePadding(lines.size() * sizeof(int32_t));
+    sink.write(reinterpret_cast<const char*>(columns.data()), columns.size() * sizeof(int32_t));
+    writePadding(columns.size() * sizeof(int32_t));
+    sink.write(reinterpret_cast<const char*>(entropies.data()), entropies.size() * sizeof(double));
+
+    sink.flush();
+}
+
+void BinaryReportWriter::write(const ScanResult& result, OutputSink& sink) {
+    BinaryReportWriter report(sink);
+    for (const auto& match : result.matches) {
+        report.writeMatch(match);
+    }
+    report.finish(result.statistics);
+}
+
+// ============================================================================
+// BinaryReportReader
+// ============================================================================
+
+BinaryReportReader::~BinaryReportReader() {
+    close();
+}
+
+void BinaryReportReader::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), data_size);
+    }
+    data = nullptr;
+    data_size = 0;
+    header = nullptr;
+    string_offsets = nullptr;
+    string_data = nullptr;
+}
+
+bool BinaryReportReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR_FMT("Cannot open report: {}", path);
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        LOG_ERROR_FMT("Not a binary report: {}", path);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        LOG_ERROR_FMT("Cannot map report: {}", path);
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    data_size = static_cast<size_t>(st.st_size);
+    header = reinterpret_cast<const Header*>(data);
+
+    if (!validate()) {
+        LOG_ERROR_FMT("Corrupt or unsupported binary report: {}", path);
+        close();
+        return false;
+    }
+
+    string_offsets = reinterpret_cast<const uint64_t*>(data + header->string_offsets_offset);
+    string_data = reinterpret_cast<const char*>(data + header->string_data_offset);
+
+    LOG_DEBUG_FMT("Opened binary report {} ({} findings, {} strings)",
+                  path, header->finding_count, header->string_count);
+    return true;
+}
+
+bool BinaryReportReader::validate() const {
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    if (header->version != FORMAT_VERSION || header->byte_order != BYTE_ORDER_MARK) {
+        return false;
+    }
+
+    // все секции должны лежать внутри файла и быть выровнены
+    const uint64_t count = header->finding_count;
+    const uint64_t strings = header->string_count;
+    if (count > data_size || strings > data_size ||
+        header->string_offsets_offset > data_size || header->string_data_offset > data_size) {
+        return false;
+    }
+
+    uint64_t offsets_end = header->string_offsets_offset + (strings + 1) * sizeof(uint64_t);
+    if (header->string_offsets_offset % 8 != 0 || offsets_end > data_size ||
+        header->string_data_offset < offsets_end) {
+        return false;
+    }
+
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + header->string_offsets_offset);
+    if (offsets[strings] > data_size || header->string_data_offset + offsets[strings] > data_size) {
+        return false;
+    }
+    for (uint64_t i = 0; i < strings; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+
+    for (int column = 0; column < COLUMN_COUNT; ++column) {
+        uint64_t begin = header->column_offsets[column];
+        if (begin % 8 != 0 || begin > data_size || begin + count * columnWidth(column) > data_size) {
+            return false;
+        }
+    }
+
+    // индексы строк не должны выходить за таблицу
+    for (int column = 0; column < COL_LINE; ++column) {
+        const uint32_t* ids = reinterpret_cast<const uint32_t*>(data + header->column_offsets[column]);
+        for (uint64_t i = 0; i < count; ++i) {
+            if (ids[i] >= strings && !(column == COL_COMMIT && ids[i] == NO_STRING)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+const uint32_t* BinaryReportReader::stringColumn(Column column) const {
+    return reinterpret_cast<const uint32_t*>(data + header->column_offsets[column]);
+}
+
+std::string BinaryReportReader::getString(uint32_t id) const {
+    if (!header || id >= header->string_count) {
+        return "";
+    }
+    return std::string(string_data + string_offsets[id],
+                       string_offsets[id + 1] - string_offsets[id]);
+}
+
+ScanStatistics BinaryReportReader::getStatistics() const {
+    ScanStatistics statistics;
+    if (!header) {
+        return statistics;
+    }
+    statistics.total_files_scanned = header->total_files_scanned;
+    statistics.total_lines_scanned = header->total_lines_scanned;
+    statistics.total_matches_found = header->total_matches_found;
+    statistics.critical_count = header->critical_count;
+    statistics.high_count = header->high_count;
+    statistics.medium_count = header->medium_count;
+    statistics.low_count = header->low_count;
+    statistics.duplicate_files = header->duplicate_files;
+    statistics.scan_time_seconds = header->scan_time_seconds;
+    statistics.baseline_suppressed = header->baseline_suppressed;
+    return statistics;
+}
+
+Match BinaryReportReader::getMatch(size_t index) const {
+    Match match;
+    if (index >= size()) {
+        return match;
+    }
+
+    match.file_path = getString(stringColumn(COL_PATH)[index]);
+    match.pattern_name = getString(stringColumn(COL_PATTERN)[index]);
+    match.severity = getString(stringColumn(COL_SEVERITY)[index]);
+    match.matched_text = getString(stringColumn(COL_MATCHED_TEXT)[index]);
+    match.preview = getString(stringColumn(COL_PREVIEW)[index]);
+    uint32_t commit = stringColumn(COL_COMMIT)[index];
+    if (commit != NO_STRING) {
+        match.commit = getString(commit);
+    }
+    match.line_number = reinterpret_cast<const int32_t*>(data + header->column_offsets[COL_LINE])[index];
+    match.column_number = reinterpret_cast<const int32_t*>(data + header->column_offsets[COL_COLUMN])[index];
+    match.entropy = reinterpret_cast<const double*>(data + header->column_offsets[COL_ENTROPY])[index];
+    return match;
+}
+
+size_t BinaryReportReader::query(const BinaryReportFilter& filter,
+                                 const std::function<void(size_t)>& callback) const {
+    if (!header) {
+        return 0;
+    }
+
+    // условия переводятся в отметки по таблице строк, дальше сравниваются только индексы
+    const uint64_t strings = header->string_count;
+    std::vector<bool> severity_ok, pattern_ok, path_ok;
+    if (!filter.severity.empty()) {
+        severity_ok = markStrings(*this, strings, [&](const std::string& s) {
+            return s == filter.severity;
+        });
+    }
+    if (!filter.pattern_name.empty()) {
+        pattern_ok = markStrings(*this, strings, [&](const std::string& s) {
+            return s == filter.pattern_name;
+        });
+    }
+    if (!filter.path_prefix.empty()) {
+        path_ok = markStrings(*this, strings, [&](const std::string& s) {
+            return s.compare(0, filter.path_prefix.size(), filter.path_prefix) == 0;
+        });
+    }
+
+    const uint32_t* severities = stringColumn(COL_SEVERITY);
+    const uint32_t* patterns = stringColumn(COL_PATTERN);
+    const uint32_t* paths = stringColumn(COL_PATH);
+
+    size_t matched = 0;
+    for (size_t i = 0; i < header->finding_count; ++i) {
+        if (!severity_ok.empty() && !severity_ok[severities[i]]) continue;
+        if (!pattern_ok.empty() && !pattern_ok[patterns[i]]) continue;
+        if (!path_ok.empty() && !path_ok[paths[i]]) continue;
+
+        matched++;
+        if (callback) {
+            callback(i);
+        }
+    }
+    return matched;
+}
+
+ScanResult BinaryReportReader::toScanResult(const BinaryReportFilter& filter) const {
+    ScanResult result;
+    result.statistics = getStatistics();
+
+    query(filter, [&](size_t index) {
+        result.matches.push_back(getMatch(index));
+    });
+
+    // при фильтрации счетчики находок пересчитываются по выборке
+    bool filtered = !filter.severity.empty() || !filter.pattern_name.empty() ||
+                    !filter.path_prefix.empty();
+    if (filtered) {
+        result.statistics.total_matches_found = 0;
+        result.statistics.critical_count = 0;
+        result.statistics.high_count = 0;
+        result.statistics.medium_count = 0;
+        result.statistics.low_count = 0;
+        result.statistics.recordMatches(result.matches);
+    }
+
+    result.has_critical = result.statistics.critical_count > 0;
+    result.has_high = result.statistics.high_count > 0;
+    return result;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include "core/secret_detector.h"
+#include "utils/output_sink.h"
+
+/**
+ * Формат бинарного отчета (.sdr), версия 1. Все числа little-endian.
+ *
+ *   [BinaryReport::Header]
+ *   [смещения строк: uint64 x (string_count + 1)]
+ *   [данные строк: UTF-8 без разделителей]
+ *   [колонки: по одной на поле находки, finding_count значений фиксированной ширины]
+ *
+ * Все секции выровнены на 8 байт. Строки (пути, паттерны, severity, текст)
+ * хранятся в общей таблице без повторов, колонки ссылаются на них по индексу.
+ */
+namespace BinaryReport {
+    constexpr char MAGIC[8] = {'S', 'D', 'R', 'E', 'P', 'O', 'R', 'T'};
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr uint32_t NO_STRING = 0xFFFFFFFF;   ///< Пустое необязательное поле (commit)
+
+    /**
+     * Колонки находок
+     */
+    enum Column {
+        COL_PATH = 0,       ///< uint32 индекс строки
+        COL_PATTERN,        ///< uint32 индекс строки
+        COL_SEVERITY,       ///< uint32 индекс строки
+        COL_MATCHED_TEXT,   ///< uint32 индекс строки
+        COL_PREVIEW,        ///< uint32 индекс строки
+        COL_COMMIT,         ///< uint32 индекс строки или NO_STRING
+        COL_LINE,           ///< int32
+        COL_COLUMN,         ///< int32
+        COL_ENTROPY,        ///< double
+        COLUMN_COUNT
+    };
+
+    /**
+     * Заголовок файла
+     */
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t finding_count;
+        uint64_t string_count;
+        uint64_t string_offsets_offset;
+        uint64_t string_data_offset;
+        uint64_t column_offsets[COLUMN_COUNT];
+
+        // статистика сканирования
+        uint64_t total_files_scanned;
+        uint64_t total_lines_scanned;
+        uint64_t total_matches_found;
+        uint64_t critical_count;
+        uint64_t high_count;
+        uint64_t medium_count;
+        uint64_t low_count;
+        uint64_t duplicate_files;
+        double scan_time_seconds;
+        uint64_t baseline_suppressed;
+        uint64_t reserved[3];
+    };
+
+    static_assert(sizeof(Header) % 8 == 0, "header must keep 8-byte alignment");
+}
+
+/**
+ * @class BinaryReportWriter
+ * @brief Запись отчета в бинарном колоночном формате
+ *
+ * Находки принимаются по одной (можно подключать к callback сканера),
+ * в памяти хранятся только колонки фиксированной ширины и уникальные строки.
+ * Файл целиком пишется в finish().
+ */
+class BinaryReportWriter {
+public:
+    explicit BinaryReportWriter(OutputSink& sink);
+    ~BinaryReportWriter() = default;
+
+    /**
+     * Добавить находку
+     */
+    void writeMatch(const Match& match);
+
+    /**
+     * Записать файл: заголовок, таблицу строк и колонки
+     */
+    void finish(const ScanStatistics& statistics);
+
+    /**
+     * Записать готовый результат целиком
+     */
+    static void write(const ScanResult& result, OutputSink& sink);
+
+private:
+    OutputSink& sink;
+
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> string_ids;
+    uint64_t string_bytes = 0;
+
+    std::vector<uint32_t> string_columns[BinaryReport::COL_LINE];
+    std::vector<int32_t> lines;
+    std::vector<int32_t> columns;
+    std::vector<double> entropies;
+
+    uint32_t intern(const std::string& str);
+    void writePadding(uint64_t written);
+};
+
+/**
+ * @struct BinaryReportFilter
+ * @brief Условия выборки находок (пустое поле - без ограничения)
+ */
+struct BinaryReportFilter {
+    std::string severity;       ///< Точное совпадение severity (e.g., "CRITICAL")
+    std::string pattern_name;   ///< Точное совпадение имени паттерна
+    std::string path_prefix;    ///< Префикс пути к файлу
+};
+
+/**
+ * @class BinaryReportReader
+ * @brief Чтение бинарного отчета через mmap
+ *
+ * Файл не разбирается целиком: находки читаются по индексу прямо из колонок,
+ * фильтры сравнивают индексы строк, а не сами строки.
+ */
+class BinaryReportReader {
+public:
+    BinaryReportReader() = default;
+    ~BinaryReportReader();
+
+    BinaryReportReader(const BinaryReportReader&) = delete;
+    BinaryReportReader& operator=(const BinaryReportReader&) = delete;
+
+    /**
+     * Открыть файл отчета
+     * @return true если файл открыт и заголовок корректен
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Закрыть файл (снять mmap)
+     */
+    void close();
+
+    /**
+     * Количество находок в отчете
+     */
+    size_t size() const { return header ? header->finding_count : 0; }
+
+    /**
+     * Статистика сканирования из заголовка
+     */
+    ScanStatistics getStatistics() const;
+
+    /**
+     * Получить находку по индексу
+     */
+    Match getMatch(size_t index) const;
+
+    /**
+     * Получить строку из таблицы строк
+     */
+    std::string getString(uint32_t id) const;
+
+    /**
+     * Обойти находки, подходящие под фильтр
+     * @param callback Вызывается с индексом находки
+     * @return Количество подходящих находок
+     */
+    size_t query(const BinaryReportFilter& filter,
+                 const std::function<void(size_t)>& callback) const;
+
+    /**
+     * Прочитать отчет в ScanResult (с учетом фильтра)
+     */
+    ScanResult toScanResult(const BinaryReportFilter& filter = BinaryReportFilter()) const;
+
+private:
+    const unsigned char* data = nullptr;
+    size_t data_size = 0;
+    const BinaryReport::Header* header = nullptr;
+    const uint64_t* string_offsets = nullptr;
+    const char* string_data = nullptr;
+
+    const uint32_t* stringColumn(BinaryReport::Column column) const;
+    bool validate() const;
+};
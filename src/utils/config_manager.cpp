@@ -1,5 +1,6 @@
 #include "utils/config_manager.h"
 #include "utils/logger.h"
+#include "core/builtin_patterns.h"
 #include <fstream>
 #include <iostream>
 
@@ -45,57 +46,25 @@ bool ConfigManager::saveJsonConfig(const json& data, const std::string& output_p
 }
 
 json ConfigManager::getDefaultPatterns() {
+    // JSON-вид таблицы встроенных паттернов (для сохранения конфига и тестов)
     json patterns;
+    patterns["patterns"] = json::object();
 
-    auto add = [&](const std::string& name,
-                   const std::string& regex,
-                   const std::string& severity,
-                   const std::string& description) {
+    for (const auto& builtin : BuiltinPatterns::TABLE) {
         json p;
-        p["regex"] = regex;
-        p["severity"] = severity;
-        p["description"] = description;
-        patterns["patterns"][name] = p;
-    };
-
-    add("aws_key",
-        R"((?i)(AKIA[0-9A-Z]{16}|aws[_-]?access[_-]?key[_-]?id|aws[_-]?secret[_-]?access[_-]?key))",
-        "CRITICAL",
-        "AWS Access Key or Secret");
-
-    add("github_token",
-        R"((?i)(github[_\-]?(token|pat|key)|ghp_[a-zA-Z0-9_]{36,255}))",
-        "CRITICAL",
-        "GitHub Personal Access Token");
-
-    add("private_key",
-        R"(-----BEGIN.*PRIVATE KEY.*-----)",
-        "CRITICAL",
-        "Private Key (RSA, DSA, EC)");
-
-    add("password_plain",
-        R"((?i)(password|passwd|pwd)\s*[:=]\s*['\"]?[^\s'"]+['\"]?)",
-        "HIGH",
-        "Password in plain text");
-
-    add("database_url",
-        R"((mongodb|mysql|postgres|redis)://[^\s]+)",
-        "HIGH",
-        "Database connection string");
-
-    add("api_key",
-        R"((?i)(api[_-]?key|apikey|api-secret|secret-key)\s*[:=]\s*['\"]?[\w\-\._]+['\"]?)",
-        "HIGH",
-        "Generic API Key");
-
-    // high_entropy — без regex, только флаг
-    json ent;
-    ent["regex"] = nullptr;
-    ent["severity"] = "MEDIUM";
-    ent["description"] = "High entropy string (possible secret)";
-    ent["use_entropy"] = true;
-    ent["entropy_threshold"] = 4.5;
-    patterns["patterns"]["high_entropy"] = ent;
+        if (builtin.regex.empty()) {
+            p["regex"] = nullptr;
+        } else {
+            p["regex"] = std::string(builtin.regex);
+        }
+        p["severity"] = std::string(severityName(builtin.severity));
+        p["description"] = std::string(builtin.description);
+        if (builtin.use_entropy) {
+            p["use_entropy"] = true;
+            p["entropy_threshold"] = builtin.entropy_threshold;
+        }
+        patterns["patterns"][std::string(builtin.name)] = p;
+    }
 
     return patterns;
 }
@@ -31,6 +31,7 @@ public:
 
     /**
      * Получить встроенный конфиг по умолчанию
+     * Строится из BuiltinPatterns::TABLE; детектору JSON не нужен (PatternMatcher::loadBuiltin).
      * @return JSON с дефолтными паттернами
      */
     static json getDefaultPatterns();
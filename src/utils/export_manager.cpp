@@ -1,5 +1,8 @@
 #include "utils/export_manager.h"
 #include "utils/logger.h"
+#include "utils/json_report_writer.h"
+#include "utils/sarif_report_writer.h"
+#include "utils/binary_report.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -23,6 +26,73 @@ bool ExportManager::exportToJson(const json& data, const std::string& output_pat
     }
 }
 
+bool ExportManager::exportToJson(const ScanResult& result, const std::string& output_path) {
+    try {
+        auto sink = FileSink::open(output_path);
+        if (!sink) {
+            LOG_ERROR_FMT("Cannot open file for writing: {}", output_path);
+            return false;
+        }
+
+        JsonReportWriter::write(result, *sink);
+        if (sink->failed()) {
+            LOG_ERROR_FMT("Error writing JSON report: {}", output_path);
+            return false;
+        }
+
+        LOG_INFO_FMT("Exported to JSON: {}", output_path);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error exporting to JSON: {}", e.what());
+        return false;
+    }
+}
+
+bool ExportManager::exportToSarif(const ScanResult& result, const std::vector<Pattern>& patterns,
+                                  const std::string& output_path) {
+    try {
+        auto sink = FileSink::open(output_path);
+        if (!sink) {
+            LOG_ERROR_FMT("Cannot open file for writing: {}", output_path);
+            return false;
+        }
+
+        SarifReportWriter::write(result, patterns, *sink);
+        if (sink->failed()) {
+            LOG_ERROR_FMT("Error writing SARIF report: {}", output_path);
+            return false;
+        }
+
+        LOG_INFO_FMT("Exported to SARIF: {}", output_path);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error exporting to SARIF: {}", e.what());
+        return false;
+    }
+}
+
+bool ExportManager::exportToBinary(const ScanResult& result, const std::string& output_path) {
+    try {
+        auto sink = FileSink::open(output_path);
+        if (!sink) {
+            LOG_ERROR_FMT("Cannot open file for writing: {}", output_path);
+            return false;
+        }
+
+        BinaryReportWriter::write(result, *sink);
+        if (sink->failed()) {
+            LOG_ERROR_FMT("Error writing binary report: {}", output_path);
+            return false;
+        }
+
+        LOG_INFO_FMT("Exported to binary report: {}", output_path);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error exporting to binary report: {}", e.what());
+        return false;
+    }
+}
+
 bool ExportManager::exportToCsv(const json& data, const std::string& output_path) {
     try {
         std::ofstream file(output_path);
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "core/secret_detector.h"
 
 using json = nlohmann::json;
 
@@ -23,6 +24,32 @@ public:
      */
     static bool exportToJson(const json& data, const std::string& output_path);
 
+    /**
+     * Экспортировать результат в JSON потоково (без построения DOM)
+     * @param result Результат сканирования
+     * @param output_path Путь до выходного файла
+     * @return true если успешно
+     */
+    static bool exportToJson(const ScanResult& result, const std::string& output_path);
+
+    /**
+     * Экспортировать результат в SARIF 2.1.0 (для code scanning)
+     * @param result Результат сканирования
+     * @param patterns Паттерны детектора (таблица rules[])
+     * @param output_path Путь до выходного файла
+     * @return true если успешно
+     */
+    static bool exportToSarif(const ScanResult& result, const std::vector<Pattern>& patterns,
+                              const std::string& output_path);
+
+    /**
+     * Экспортировать результат в компактный бинарный формат (.sdr)
+     * @param result Результат сканирования
+     * @param output_path Путь до выходного файла
+     * @return true если успешно
+     */
+    static bool exportToBinary(const ScanResult& result, const std::string& output_path);
+
     /**
      * Экспортировать в CSV
      * @param data JSON данные результатов
@@ -1,4 +1,5 @@
 #include "utils/file_utils.h"
+#include "utils/trace_recorder.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -8,11 +9,16 @@ namespace fs = std::filesystem;
 
 std::string FileUtils::readFile(const std::string& file_path) {
     try {
-        std::ifstream file(file_path);
+        std::ifstream file;
+        {
+            TRACE_SCOPE_DETAIL("open", "io", &file_path);
+            file.open(file_path);
+        }
         if (!file.is_open()) {
             return "";
         }
 
+        TRACE_SCOPE_DETAIL("read", "io", &file_path);
         std::stringstream buffer;
         buffer << file.rdbuf();
         return buffer.str();
@@ -0,0 +1,552 @@
+#include "utils/git_object_store.h"
+#include "utils/logger.h"
+#include "utils/file_utils.h"
+#include <filesystem>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
+#include <zlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // максимальная глубина цепочки дельт (git по умолчанию использует 50)
+    constexpr int MAX_DELTA_DEPTH = 128;
+    // бюджет памяти кэша баз дельт
+    constexpr size_t DELTA_CACHE_LIMIT = 64 * 1024 * 1024;
+
+    // idx v2: заголовок и fanout, затем на объект SHA-1 (20), CRC32 (4) и offset (4),
+    // в конце контрольные суммы pack и idx (по 20)
+    constexpr size_t IDX_HEADER_SIZE = 8 + 256 * 4;
+    constexpr size_t IDX_ENTRY_SIZE = 20 + 4 + 4;
+    constexpr size_t IDX_TRAILER_SIZE = 20 + 20;
+
+    // deflate сжимает не сильнее ~1032:1 - заявленный размер больше невозможен
+    constexpr size_t MAX_DEFLATE_RATIO = 1032;
+
+    constexpr int PACK_OFS_DELTA = 6;
+    constexpr int PACK_REF_DELTA = 7;
+
+    uint32_t readBE32(const unsigned char* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+               (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    bool hexToRaw(const std::string& hex, unsigned char* raw) {
+        if (hex.size() != 40) {
+            return false;
+        }
+        for (size_t i = 0; i < 20; ++i) {
+            unsigned int byte = 0;
+            if (std::sscanf(hex.c_str() + i * 2, "%2x", &byte) != 1) {
+                return false;
+            }
+            raw[i] = static_cast<unsigned char>(byte);
+        }
+        return true;
+    }
+
+    bool isHexOid(const std::string& s) {
+        return s.size() == 40 &&
+               std::all_of(s.begin(), s.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+    }
+
+    const unsigned char* mapFile(const std::string& path, size_t& size) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return nullptr;
+        }
+        size = static_cast<size_t>(st.st_size);
+        return static_cast<const unsigned char*>(data);
+    }
+
+    GitObjectType typeFromName(const std::string& name) {
+        if (name == "commit") return GitObjectType::Commit;
+        if (name == "tree") return GitObjectType::Tree;
+        if (name == "blob") return GitObjectType::Blob;
+        if (name == "tag") return GitObjectType::Tag;
+        return GitObjectType::None;
+    }
+}
+
+GitObjectStore::~GitObjectStore() {
+    for (auto& pack : packs) {
+        if (pack->idx_data) {
+            munmap(const_cast<unsigned char*>(pack->idx_data), pack->idx_size);
+        }
+        if (pack->pack_data) {
+            munmap(const_cast<unsigned char*>(pack->pack_data), pack->pack_size);
+        }
+    }
+}
+
+bool GitObjectStore::open(const std::string& repo_path) {
+    fs::path base(repo_path);
+
+    // рабочая копия (.git - директория или файл "gitdir: ...") или bare-репозиторий
+    if (fs::is_directory(base / ".git")) {
+        git_dir = (base / ".git").string();
+    } else if (fs::is_regular_file(base / ".git")) {
+        std::string content = FileUtils::readFile((base / ".git").string());
+        if (content.rfind("gitdir:", 0) != 0) {
+            LOG_ERROR_FMT("Unsupported .git file in: {}", repo_path);
+            return false;
+        }
+        std::string target = content.substr(7);
+        target.erase(0, target.find_first_not_of(" \t"));
+        target.erase(target.find_last_not_of(" \t\r\n") + 1);
+        fs::path target_path(target);
+        git_dir = (target_path.is_absolute() ? target_path : base / target_path).string();
+    } else if (fs::is_directory(base / "objects") && fs::exists(base / "HEAD")) {
+        git_dir = base.string();
+    } else {
+        LOG_ERROR_FMT("Not a git repository: {}", repo_path);
+        return false;
+    }
+
+    // у linked worktree объекты лежат в общей директории
+    std::string commondir = FileUtils::readFile(git_dir + "/commondir");
+    if (!commondir.empty()) {
+        commondir.erase(commondir.find_last_not_of(" \t\r\n") + 1);
+        fs::path common(commondir);
+        git_dir = (common.is_absolute() ? common : fs::path(git_dir) / common).lexically_normal().string();
+    }
+
+    if (!fs::is_directory(git_dir + "/objects")) {
+        LOG_ERROR_FMT("No object database in: {}", git_dir);
+        return false;
+    }
+
+    loadPacks();
+    LOG_DEBUG_FMT("Opened git object store {} ({} packs)", git_dir, packs.size());
+    return true;
+}
+
+bool GitObjectStore::loadPacks() {
+    std::string pack_dir = git_dir + "/objects/pack";
+    if (!fs::is_directory(pack_dir)) {
+        return true;
+    }
+
+    for (const auto& entry : fs::directory_iterator(pack_dir)) {
+        std::string path = entry.path().string();
+        if (entry.path().extension() != ".idx") {
+            continue;
+        }
+
+        auto pack = std::make_unique<PackFile>();
+        pack->pack_path = path.substr(0, path.size() - 4) + ".pack";
+        pack->idx_data = mapFile(path, pack->idx_size);
+        pack->pack_data = mapFile(pack->pack_path, pack->pack_size);
+
+        // поддерживается только idx v2: "\377tOc", version 2
+        bool valid = pack->idx_data && pack->pack_data &&
+                     pack->idx_size >= 8 + 256 * 4 &&
+                     std::memcmp(pack->idx_data, "\377tOc", 4) == 0 &&
+                     readBE32(pack->idx_data + 4) == 2 &&
+                     pack->pack_size >= 12 &&
+                     std::memcmp(pack->pack_data, "PACK", 4) == 0;
+
+        // невалидный pack остается в списке с нулем объектов, чтобы деструктор снял mmap
+        if (!valid) {
+            LOG_WARN_FMT("Unsupported or corrupt packfile: {}", pack->pack_path);
+            packs.push_back(std::move(pack));
+            continue;
+        }
+
+        // fanout неубывающий, а таблицы на object_count объектов помещаются в idx
+        const unsigned char* fanout = pack->idx_data + 8;
+        uint32_t count = readBE32(fanout + 255 * 4);
+        for (size_t i = 1; i < 256 && valid; ++i) {
+            valid = readBE32(fanout + (i - 1) * 4) <= readBE32(fanout + i * 4);
+        }
+        size_t tables_size = IDX_HEADER_SIZE + size_t(count) * IDX_ENTRY_SIZE + IDX_TRAILER_SIZE;
+        if (!valid || pack->idx_size < tables_size || (pack->idx_size - tables_size) % 8 != 0) {
+            LOG_WARN_FMT("Corrupt pack index: {}", path);
+            packs.push_back(std::move(pack));
+            continue;
+        }
+
+        pack->object_count = count;
+        pack->large_offset_count = static_cast<uint32_t>((pack->idx_size - tables_size) / 8);
+        packs.push_back(std::move(pack));
+    }
+
+    return true;
+}
+
+bool GitObjectStore::readObject(const std::string& oid, GitObject& object) {
+    return readObject(oid, object, 0);
+}
+
+bool GitObjectStore::readObject(const std::string& oid, GitObject& object, int depth) {
+    unsigned char raw[20];
+    if (!hexToRaw(oid, raw)) {
+        return false;
+    }
+
+    for (const auto& pack : packs) {
+        uint64_t offset = 0;
+        if (pack->object_count > 0 && findInPack(*pack, raw, offset)) {
+            return readPackedObject(*pack, offset, object, depth);
+        }
+    }
+
+    return readLooseObject(oid, object);
+}
+
+bool GitObjectStore::readLooseObject(const std::string& oid, GitObject& object) const {
+    std::string path = git_dir + "/objects/" + oid.substr(0, 2) + "/" + oid.substr(2);
+
+    size_t size = 0;
+    const unsigned char* data = mapFile(path, size);
+    if (!data) {
+        return false;
+    }
+
+    std::string raw;
+    bool ok = inflate(data, size, 0, raw);
+    munmap(const_cast<unsigned char*>(data), size);
+    if (!ok) {
+        LOG_WARN_FMT("Corrupt loose object: {}", oid);
+        return false;
+    }
+
+    // заголовок: "<type> <size>\0"
+    size_t space = raw.find(' ');
+    size_t nul = raw.find('\0');
+    if (space == std::string::npos || nul == std::string::npos || space > nul) {
+        return false;
+    }
+
+    object.type = typeFromName(raw.substr(0, space));
+    object.data = raw.substr(nul + 1);
+    return object.type != GitObjectType::None;
+}
+
+bool GitObjectStore::findInPack(const PackFile& pack, const unsigned char* raw_oid, uint64_t& offset) const {
+    const unsigned char* fanout = pack.idx_data + 8;
+    uint32_t lo = raw_oid[0] == 0 ? 0 : readBE32(fanout + (raw_oid[0] - 1) * 4);
+    uint32_t hi = readBE32(fanout + raw_oid[0] * 4);
+
+    const unsigned char* shas = fanout + 256 * 4;
+    const size_t n = pack.object_count;
+
+    // бинарный поиск в отсортированной таблице SHA-1
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int cmp = std::memcmp(shas + size_t(mid) * 20, raw_oid, 20);
+        if (cmp == 0) {
+            const unsigned char* offsets = shas + n * 20 + n * 4;
+            uint32_t off32 = readBE32(offsets + size_t(mid) * 4);
+            if (off32 & 0x80000000u) {
+                // большой offset хранится в отдельной 64-битной таблице
+                uint32_t index = off32 & 0x7fffffffu;
+                if (index >= pack.large_offset_count) {
+                    return false;
+                }
+                const unsigned char* off64 = offsets + n * 4 + size_t(index) * 8;
+                offset = (uint64_t(readBE32(off64)) << 32) | readBE32(off64 + 4);
+            } else {
+                offset = off32;
+            }
+            return true;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+bool GitObjectStore::readPackedObject(const PackFile& pack, uint64_t offset, GitObject& object, int depth) {
+    if (depth > MAX_DELTA_DEPTH || offset >= pack.pack_size) {
+        return false;
+    }
+
+    std::string cache_key = pack.pack_path + ":" + std::to_string(offset);
+    auto cached = delta_cache.find(cache_key);
+    if (cached != delta_cache.end()) {
+        object = *cached->second;
+        return true;
+    }
+
+    const unsigned char* p = pack.pack_data + offset;
+    const unsigned char* end = pack.pack_data + pack.pack_size;
+
+    // заголовок записи: тип (3 бита) и размер (varint)
+    unsigned char c = *p++;
+    int type = (c >> 4) & 0x7;
+    uint64_t size = c & 0x0f;
+    int shift = 4;
+    while (c & 0x80) {
+        if (p >= end || shift > 57) {
+            return false;
+        }
+        c = *p++;
+        size |= uint64_t(c & 0x7f) << shift;
+        shift += 7;
+    }
+
+    if (type >= 1 && type <= 4) {
+        object.type = static_cast<GitObjectType>(type);
+        return inflate(p, end - p, size, object.data);
+    }
+
+    GitObject base;
+    if (type == PACK_OFS_DELTA) {
+        // отрицательное смещение базы относительно текущей записи
+        if (p >= end) {
+            return false;
+        }
+        c = *p++;
+        uint64_t base_distance = c & 0x7f;
+        while (c & 0x80) {
+            if (p >= end || base_distance > offset) {
+                return false;
+            }
+            c = *p++;
+            base_distance = ((base_distance + 1) << 7) | (c & 0x7f);
+        }
+        if (base_distance == 0 || base_distance > offset) {
+            return false;
+        }
+        uint64_t base_offset = offset - base_distance;
+        if (!readPackedObject(pack, base_offset, base, depth + 1)) {
+            return false;
+        }
+        cacheDeltaBase(pack, base_offset, base);
+    } else if (type == PACK_REF_DELTA) {
+        if (end - p < 20) {
+            return false;
+        }
+        std::string base_oid = toHex(p);
+        p += 20;
+        // глубина общая с OFS_DELTA - цикл из REF_DELTA не уводит в бесконечную рекурсию
+        if (!readObject(base_oid, base, depth + 1)) {
+            return false;
+        }
+    } else {
+        LOG_WARN_FMT("Unknown pack entry type {} in {}", type, pack.pack_path);
+        return false;
+    }
+
+    std::string delta;
+    if (!inflate(p, end - p, size, delta)) {
+        return false;
+    }
+
+    object.type = base.type;
+    return applyDelta(base.data, delta, object.data);
+}
+
+void GitObjectStore::cacheDeltaBase(const PackFile& pack, uint64_t offset, const GitObject& object) {
+    if (object.data.size() > DELTA_CACHE_LIMIT / 4) {
+        return;
+    }
+    if (delta_cache_bytes + object.data.size() > DELTA_CACHE_LIMIT) {
+        delta_cache.clear();
+        delta_cache_bytes = 0;
+    }
+    std::string cache_key = pack.pack_path + ":" + std::to_string(offset);
+    if (delta_cache.emplace(cache_key, std::make_shared<GitObject>(object)).second) {
+        delta_cache_bytes += object.data.size();
+    }
+}
+
+bool GitObjectStore::inflate(const unsigned char* data, size_t size, size_t expected, std::string& out) {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+
+    // заявленный размер из заголовка не доверенный: буфер растет по мере распаковки
+    if (expected > 0 && expected / MAX_DEFLATE_RATIO > size) {
+        inflateEnd(&stream);
+        return false;
+    }
+    // байт сверх заявленного: zlib дописывает конец потока, а лишние данные видны по размеру
+    const size_t limit = expected > 0 ? expected + 1 : SIZE_MAX;
+
+    out.clear();
+    out.resize(std::min(limit, std::max<size_t>(size * 2, 256)));
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(std::min<size_t>(size, UINT32_MAX));
+
+    int ret = Z_OK;
+    size_t produced = 0;
+    while (ret != Z_STREAM_END) {
+        if (produced == out.size()) {
+            if (produced == limit) {
+                break;  // данных больше, чем заявлено в заголовке
+            }
+            out.resize(std::min(limit, out.size() * 2));
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(&out[produced]);
+        stream.avail_out = static_cast<uInt>(std::min<size_t>(out.size() - produced, UINT32_MAX));
+
+        ret = ::inflate(&stream, Z_NO_FLUSH);
+        produced = stream.total_out;
+
+        if (ret != Z_OK && ret != Z_STREAM_END) {
+            break;
+        }
+    }
+
+    inflateEnd(&stream);
+    if (ret != Z_STREAM_END || (expected > 0 && produced != expected)) {
+        return false;
+    }
+    out.resize(produced);
+    return true;
+}
+
+bool GitObjectStore::applyDelta(const std::string& base, const std::string& delta, std::string& out) {
+    size_t pos = 0;
+    auto readVarint = [&](uint64_t& value) {
+        value = 0;
+        int shift = 0;
+        unsigned char c;
+        do {
+            if (pos >= delta.size()) {
+                return false;
+            }
+            c = static_cast<unsigned char>(delta[pos++]);
+            value |= uint64_t(c & 0x7f) << shift;
+            shift += 7;
+        } while (c & 0x80);
+        return true;
+    };
+
+    uint64_t base_size = 0;
+    uint64_t result_size = 0;
+    if (!readVarint(base_size) || !readVarint(result_size) || base_size != base.size()) {
+        return false;
+    }
+
+    // размер результата из заголовка дельты не доверенный
+    out.clear();
+    out.reserve(std::min<uint64_t>(result_size, base.size() + delta.size()));
+
+    while (pos < delta.size()) {
+        unsigned char op = static_cast<unsigned char>(delta[pos++]);
+        if (op & 0x80) {
+            // копирование из базы: биты 0-3 - offset, биты 4-6 - размер
+            uint64_t copy_offset = 0;
+            uint64_t copy_size = 0;
+            for (int i = 0; i < 4; ++i) {
+                if (op & (1 << i)) {
+                    if (pos >= delta.size()) return false;
+                    copy_offset |= uint64_t(static_cast<unsigned char>(delta[pos++])) << (8 * i);
+                }
+            }
+            for (int i = 0; i < 3; ++i) {
+                if (op & (0x10 << i)) {
+                    if (pos >= delta.size()) return false;
+                    copy_size |= uint64_t(static_cast<unsigned char>(delta[pos++])) << (8 * i);
+                }
+            }
+            if (copy_size == 0) {
+                copy_size = 0x10000;
+            }
+            if (copy_offset + copy_size > base.size() || out.size() + copy_size > result_size) {
+                return false;
+            }
+            out.append(base, copy_offset, copy_size);
+        } else if (op != 0) {
+            // вставка op байт из самой дельты
+            if (pos + op > delta.size() || out.size() + op > result_size) {
+                return false;
+            }
+            out.append(delta, pos, op);
+            pos += op;
+        } else {
+            return false;  // зарезервированный opcode
+        }
+    }
+
+    return out.size() == result_size;
+}
+
+std::vector<GitRef> GitObjectStore::listRefs() const {
+    std::vector<GitRef> refs;
+
+    auto trim = [](std::string s) {
+        s.erase(s.find_last_not_of(" \t\r\n") + 1);
+        return s;
+    };
+
+    // HEAD может быть detached (SHA) или символической ссылкой
+    std::string head = trim(FileUtils::readFile(git_dir + "/HEAD"));
+    if (isHexOid(head)) {
+        refs.push_back({"HEAD", head});
+    }
+
+    // loose refs
+    std::string refs_dir = git_dir + "/refs";
+    if (fs::is_directory(refs_dir)) {
+        for (const auto& entry : fs::recursive_directory_iterator(refs_dir)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            std::string value = trim(FileUtils::readFile(entry.path().string()));
+            if (isHexOid(value)) {
+                std::string name = fs::relative(entry.path(), git_dir).generic_string();
+                refs.push_back({name, value});
+            }
+        }
+    }
+
+    // packed-refs: "<sha> <name>", строки "^<sha>" - peeled теги (пропускаем, теги разыменуются отдельно)
+    std::istringstream packed(FileUtils::readFile(git_dir + "/packed-refs"));
+    std::string line;
+    while (std::getline(packed, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == '^') {
+            continue;
+        }
+        size_t space = line.find(' ');
+        if (space == std::string::npos) {
+            continue;
+        }
+        std::string oid = line.substr(0, space);
+        std::string name = line.substr(space + 1);
+        bool duplicate = std::any_of(refs.begin(), refs.end(),
+                                     [&](const GitRef& r) { return r.name == name; });
+        if (isHexOid(oid) && !duplicate) {
+            refs.push_back({name, oid});
+        }
+    }
+
+    return refs;
+}
+
+std::string GitObjectStore::toHex(const unsigned char* raw) {
+    static const char* digits = "0123456789abcdef";
+    std::string hex(40, '0');
+    for (size_t i = 0; i < 20; ++i) {
+        hex[i * 2] = digits[raw[i] >> 4];
+        hex[i * 2 + 1] = digits[raw[i] & 0x0f];
+    }
+    return hex;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * @enum GitObjectType
+ * @brief Типы объектов git (значения совпадают с кодами в packfile)
+ */
+enum class GitObjectType {
+    None = 0,
+    Commit = 1,
+    Tree = 2,
+    Blob = 3,
+    Tag = 4
+};
+
+/**
+ * @struct GitObject
+ * @brief Распакованный объект git
+ */
+struct GitObject {
+    GitObjectType type = GitObjectType::None;
+    std::string data;
+};
+
+/**
+ * @struct GitRef
+ * @brief Ссылка (ветка, тег, HEAD) и объект, на который она указывает
+ */
+struct GitRef {
+    std::string name;   ///< Имя ссылки (e.g., "refs/heads/main")
+    std::string oid;    ///< SHA-1 объекта (hex)
+};
+
+/**
+ * @class GitObjectStore
+ * @brief Чтение объектной базы git напрямую: loose objects и packfiles
+ *
+ * Не требует установленного git: объекты распаковываются через zlib,
+ * дельты (OFS_DELTA / REF_DELTA) в packfile восстанавливаются на месте.
+ */
+class GitObjectStore {
+public:
+    GitObjectStore() = default;
+    ~GitObjectStore();
+
+    GitObjectStore(const GitObjectStore&) = delete;
+    GitObjectStore& operator=(const GitObjectStore&) = delete;
+
+    /**
+     * Открыть репозиторий
+     * @param repo_path Путь до рабочей копии или bare-репозитория
+     * @return true если найдена директория .git с объектами
+     */
+    bool open(const std::string& repo_path);
+
+    /**
+     * Прочитать объект по SHA-1
+     * @param oid SHA-1 в hex (40 символов)
+     * @param object Результат
+     * @return true если объект найден и успешно распакован
+     */
+    bool readObject(const std::string& oid, GitObject& object);
+
+    /**
+     * Получить все ссылки репозитория (HEAD, refs/, packed-refs)
+     */
+    std::vector<GitRef> listRefs() const;
+
+    /**
+     * Путь до директории .git
+     */
+    const std::string& getGitDir() const { return git_dir; }
+
+    /**
+     * Преобразовать 20 байт SHA-1 в hex
+     */
+    static std::string toHex(const unsigned char* raw);
+
+private:
+    struct PackFile {
+        std::string pack_path;
+        const unsigned char* idx_data = nullptr;
+        size_t idx_size = 0;
+        const unsigned char* pack_data = nullptr;
+        size_t pack_size = 0;
+        uint32_t object_count = 0;
+        uint32_t large_offset_count = 0;    ///< Записей в таблице 64-битных offset'ов
+    };
+
+    std::string git_dir;
+    std::vector<std::unique_ptr<PackFile>> packs;
+
+    // кэш восстановленных баз дельт: (pack, offset) -> объект
+    std::unordered_map<std::string, std::shared_ptr<GitObject>> delta_cache;
+    size_t delta_cache_bytes = 0;
+
+    bool loadPacks();
+    bool readObject(const std::string& oid, GitObject& object, int depth);
+    bool readLooseObject(const std::string& oid, GitObject& object) const;
+    bool findInPack(const PackFile& pack, const unsigned char* raw_oid, uint64_t& offset) const;
+    bool readPackedObject(const PackFile& pack, uint64_t offset, GitObject& object, int depth);
+    void cacheDeltaBase(const PackFile& pack, uint64_t offset, const GitObject& object);
+
+    static bool inflate(const unsigned char* data, size_t size, size_t expected, std::string& out);
+    static bool applyDelta(const std::string& base, const std::string& delta, std::string& out);
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class HashUtils
+ * @brief Быстрые некриптографические хэши (XXH64) для дедупликации и отпечатков
+ */
+class HashUtils {
+public:
+    HashUtils() = default;
+    ~HashUtils() = default;
+
+    /**
+     * Рассчитать XXH64 для блока данных
+     * @param data Указатель на данные
+     * @param size Размер данных в байтах
+     * @param seed Начальное значение
+     * @return 64-битный хэш
+     */
+    static uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+
+    /**
+     * Рассчитать XXH64 для строки
+     */
+    static uint64_t hash64(const std::string& str, uint64_t seed = 0) {
+        return hash64(str.data(), str.size(), seed);
+    }
+
+    /**
+     * Представить хэш в виде 16 hex-символов
+     */
+    static std::string toHex(uint64_t hash);
+};
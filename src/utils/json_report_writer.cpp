@@ -0,0 +1,111 @@
+#include "utils/json_report_writer.h"
+
+JsonReportWriter::JsonReportWriter(OutputSink& s, int indent)
+    : sink(s), writer(s, indent) {}
+
+void JsonReportWriter::begin() {
+    writer.beginObject();
+    writer.key("results");
+    writer.beginArray();
+}
+
+void JsonReportWriter::writeMatch(const Match& match) {
+    writer.beginObject();
+    writer.field("column_number", match.column_number);
+    if (!match.commit.empty()) {
+        writer.field("commit", match.commit);
+    }
+    if (match.entropy > 0) {
+        writer.field("entropy", match.entropy);
+    }
+    writer.field("file_path", match.file_path);
+    writer.field("line_number", match.line_number);
+    writer.field("matched_text", match.matched_text);
+    writer.field("pattern_name", match.pattern_name);
+    writer.field("preview", match.preview);
+    writer.field("severity", match.severity);
+    writer.endObject();
+}
+
+void JsonReportWriter::finish(const ScanStatistics& statistics, bool has_critical, bool has_high,
+                              const std::vector<PatternProfile>& pattern_profile) {
+    writer.endArray();
+
+    writer.key("scan_summary");
+    writer.beginObject();
+    if (statistics.baseline_suppressed > 0) {
+        writer.field("baseline_suppressed", statistics.baseline_suppressed);
+    }
+    if (statistics.cancelled) {
+        writer.field("cancelled", true);
+    }
+    writer.field("has_critical", has_critical);
+    writer.field("has_high", has_high);
+    if (!statistics.partial_files.empty()) {
+        writer.field("partial_files", statistics.partial_files.size());
+    }
+    writer.field("scan_time_seconds", statistics.scan_time_seconds);
+    writer.field("total_files", statistics.total_files_scanned);
+    writer.field("total_lines", statistics.total_lines_scanned);
+    writer.field("total_matches", statistics.total_matches_found);
+    writer.endObject();
+
+    writer.key("severity_breakdown");
+    writer.beginObject();
+    writer.field("critical", statistics.critical_count);
+    writer.field("high", statistics.high_count);
+    writer.field("low", statistics.low_count);
+    writer.field("medium", statistics.medium_count);
+    writer.endObject();
+
+    writer.key("statistics");
+    writer.beginObject();
+    writer.field("critical_count", statistics.critical_count);
+    writer.field("high_count", statistics.high_count);
+    writer.field("low_count", statistics.low_count);
+    writer.field("medium_count", statistics.medium_count);
+    if (!statistics.partial_files.empty()) {
+        writer.key("partial_files");
+        writer.beginArray();
+        for (const auto& partial : statistics.partial_files) {
+            writer.beginObject();
+            writer.field("cause", partialCauseName(partial.cause));
+            writer.field("file", partial.file_path);
+            writer.field("reason", partial.reason);
+            writer.endObject();
+        }
+        writer.endArray();
+    }
+    if (!pattern_profile.empty()) {
+        writer.key("pattern_profile");
+        writer.beginArray();
+        for (const auto& entry : pattern_profile) {
+            writer.beginObject();
+            writer.field("bytes_examined", entry.bytes_examined);
+            writer.field("candidates", entry.candidates);
+            writer.field("confirmed", entry.confirmed);
+            writer.field("pattern", entry.name);
+            writer.field("time_ms", entry.time_ns / 1e6);
+            writer.endObject();
+        }
+        writer.endArray();
+    }
+    writer.field("scan_time_seconds", statistics.scan_time_seconds);
+    writer.field("total_files_scanned", statistics.total_files_scanned);
+    writer.field("total_lines_scanned", statistics.total_lines_scanned);
+    writer.field("total_matches_found", statistics.total_matches_found);
+    writer.endObject();
+
+    writer.endObject();
+    sink.write("\n", 1);
+    sink.flush();
+}
+
+void JsonReportWriter::write(const ScanResult& result, OutputSink& sink, int indent) {
+    JsonReportWriter report(sink, indent);
+    report.begin();
+    for (const auto& match : result.matches) {
+        report.writeMatch(match);
+    }
+    report.finish(result.statistics, result.has_critical, result.has_high, result.pattern_profile);
+}
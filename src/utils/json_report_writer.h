@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include "core/secret_detector.h"
+#include "utils/json_stream_writer.h"
+
+/**
+ * @class JsonReportWriter
+ * @brief Потоковая запись JSON отчета в схеме ScanResult::to_json()
+ *
+ * Ключи пишутся в алфавитном порядке, как у nlohmann::json, поэтому
+ * массив "results" идет первым и находки можно писать по мере обнаружения,
+ * а сводку - в самом конце.
+ */
+class JsonReportWriter {
+public:
+    /**
+     * @param sink Приемник данных
+     * @param indent Отступ (как у json::dump)
+     */
+    explicit JsonReportWriter(OutputSink& sink, int indent = 2);
+    ~JsonReportWriter() = default;
+
+    /**
+     * Начать отчет (открыть объект и массив results)
+     */
+    void begin();
+
+    /**
+     * Записать одну находку
+     */
+    void writeMatch(const Match& match);
+
+    /**
+     * Завершить отчет: закрыть results и записать сводку
+     * @param pattern_profile Профиль паттернов (пишется в statistics, если не пуст)
+     */
+    void finish(const ScanStatistics& statistics, bool has_critical, bool has_high,
+                const std::vector<PatternProfile>& pattern_profile = {});
+
+    /**
+     * Записать готовый результат целиком
+     */
+    static void write(const ScanResult& result, OutputSink& sink, int indent = 2);
+
+private:
+    OutputSink& sink;
+    JsonStreamWriter writer;
+};
@@ -0,0 +1,228 @@
+#include "utils/json_stream_writer.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+JsonStreamWriter::JsonStreamWriter(OutputSink& s, int ind) : sink(s), indent(ind) {}
+
+void JsonStreamWriter::newline(size_t depth) {
+    if (indent < 0) {
+        return;
+    }
+    scratch.assign(1, '\n');
+    scratch.append(depth * static_cast<size_t>(indent), ' ');
+    sink.write(scratch);
+}
+
+void JsonStreamWriter::beforeValue() {
+    if (after_key) {
+        after_key = false;
+        return;
+    }
+    if (!stack.empty()) {
+        // элемент массива
+        if (stack.back().count++ > 0) {
+            sink.write(",", 1);
+        }
+        newline(stack.size());
+    }
+}
+
+void JsonStreamWriter::beginObject() {
+    beforeValue();
+    sink.write("{", 1);
+    stack.push_back({false, 0});
+}
+
+void JsonStreamWriter::endObject() {
+    bool empty = stack.back().count == 0;
+    stack.pop_back();
+    if (!empty) {
+        newline(stack.size());
+    }
+    sink.write("}", 1);
+}
+
+void JsonStreamWriter::beginArray() {
+    beforeValue();
+    sink.write("[", 1);
+    stack.push_back({true, 0});
+}
+
+void JsonStreamWriter::endArray() {
+    bool empty = stack.back().count == 0;
+    stack.pop_back();
+    if (!empty) {
+        newline(stack.size());
+    }
+    sink.write("]", 1);
+}
+
+void JsonStreamWriter::key(const std::string& name) {
+    if (stack.back().count++ > 0) {
+        sink.write(",", 1);
+    }
+    newline(stack.size());
+
+    scratch.clear();
+    escapeString(name, scratch);
+    scratch.append(indent < 0 ? ":" : ": ");
+    sink.write(scratch);
+    after_key = true;
+}
+
+void JsonStreamWriter::value(const std::string& str) {
+    beforeValue();
+    scratch.clear();
+    escapeString(str, scratch);
+    sink.write(scratch);
+}
+
+void JsonStreamWriter::value(bool b) {
+    beforeValue();
+    sink.write(b ? "true" : "false", b ? 4 : 5);
+}
+
+void JsonStreamWriter::value(double d) {
+    beforeValue();
+    sink.write(formatDouble(d));
+}
+
+void JsonStreamWriter::value(long long i) {
+    beforeValue();
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), i);
+    sink.write(buf, res.ptr - buf);
+}
+
+void JsonStreamWriter::value(unsigned long long u) {
+    beforeValue();
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), u);
+    sink.write(buf, res.ptr - buf);
+}
+
+void JsonStreamWriter::null() {
+    beforeValue();
+    sink.write("null", 4);
+}
+
+void JsonStreamWriter::escapeString(const std::string& str, std::string& out) {
+    static const char* hex = "0123456789abcdef";
+    out.push_back('"');
+
+    const size_t n = str.size();
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+
+        if (c < 0x80) {
+            switch (c) {
+                case '"':  out.append("\\\""); break;
+                case '\\': out.append("\\\\"); break;
+                case '\b': out.append("\\b"); break;
+                case '\f': out.append("\\f"); break;
+                case '\n': out.append("\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                default:
+                    if (c < 0x20) {
+                        out.append("\\u00");
+                        out.push_back(hex[c >> 4]);
+                        out.push_back(hex[c & 0x0f]);
+                    } else {
+                        out.push_back(static_cast<char>(c));
+                    }
+            }
+            ++i;
+            continue;
+        }
+
+        // многобайтовая последовательность UTF-8: проверить и скопировать как есть;
+        // невалидная заменяется одним U+FFFD на максимальный корректный префикс,
+        // как в nlohmann::json::dump(error_handler_t::replace)
+        size_t len = 0;
+        unsigned char second_min = 0x80;
+        unsigned char second_max = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) { len = 2; }
+        else if (c == 0xE0) { len = 3; second_min = 0xA0; }
+        else if (c == 0xED) { len = 3; second_max = 0x9F; }     // без суррогатов
+        else if (c >= 0xE1 && c <= 0xEF) { len = 3; }
+        else if (c == 0xF0) { len = 4; second_min = 0x90; }
+        else if (c >= 0xF1 && c <= 0xF3) { len = 4; }
+        else if (c == 0xF4) { len = 4; second_max = 0x8F; }    // не больше U+10FFFF
+
+        size_t k = 1;
+        while (len > 0 && k < len && i + k < n) {
+            unsigned char cc = static_cast<unsigned char>(str[i + k]);
+            unsigned char lo = k == 1 ? second_min : 0x80;
+            unsigned char hi = k == 1 ? second_max : 0xBF;
+            if (cc < lo || cc > hi) {
+                break;
+            }
+            ++k;
+        }
+
+        if (len > 0 && k == len) {
+            out.append(str, i, len);
+        } else {
+            out.append("\xEF\xBF\xBD");  // U+FFFD
+        }
+        // байт, на котором последовательность оборвалась, разбирается заново
+        i += k;
+    }
+
+    out.push_back('"');
+}
+
+std::string JsonStreamWriter::formatDouble(double d) {
+    if (!std::isfinite(d)) {
+        return "null";
+    }
+    if (d == 0.0) {
+        return std::signbit(d) ? "-0.0" : "0.0";
+    }
+
+    // кратчайшее представление в научной нотации: "-d.ddde±XX"
+    char buf[64];
+    auto res = std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::scientific);
+    std::string sci(buf, res.ptr);
+
+    std::string sign;
+    if (sci[0] == '-') {
+        sign = "-";
+        sci.erase(0, 1);
+    }
+    size_t e_pos = sci.find('e');
+    std::string digits = sci.substr(0, e_pos);
+    if (digits.size() > 1) {
+        digits.erase(1, 1);  // убрать точку
+    }
+    int n = std::atoi(sci.c_str() + e_pos + 1) + 1;  // value = 0.digits * 10^n
+    int k = static_cast<int>(digits.size());
+
+    // правила nlohmann::json (grisu2 format_buffer): min_exp = -4, max_exp = 15
+    constexpr int min_exp = -4;
+    constexpr int max_exp = 15;
+    std::string out;
+
+    if (k <= n && n <= max_exp) {
+        out = digits + std::string(n - k, '0') + ".0";
+    } else if (0 < n && n <= max_exp) {
+        out = digits.substr(0, n) + "." + digits.substr(n);
+    } else if (min_exp < n && n <= 0) {
+        out = "0." + std::string(-n, '0') + digits;
+    } else {
+        out = digits.substr(0, 1);
+        if (k > 1) {
+            out += "." + digits.substr(1);
+        }
+        int e = n - 1;
+        char exp_buf[16];
+        std::snprintf(exp_buf, sizeof(exp_buf), "e%c%02d", e < 0 ? '-' : '+', std::abs(e));
+        out += exp_buf;
+    }
+
+    return sign + out;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "utils/output_sink.h"
+
+/**
+ * @class JsonStreamWriter
+ * @brief Потоковая (SAX-style) запись JSON без построения DOM
+ *
+ * Формат совпадает с nlohmann::json::dump(indent): те же отступы,
+ * экранирование строк и запись чисел с плавающей точкой.
+ * Ключи пишутся в том порядке, в котором их передали.
+ */
+class JsonStreamWriter {
+public:
+    /**
+     * @param sink Приемник данных
+     * @param indent Отступ (-1 = компактный вывод в одну строку)
+     */
+    explicit JsonStreamWriter(OutputSink& sink, int indent = 2);
+    ~JsonStreamWriter() = default;
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * Ключ следующего значения (только внутри объекта)
+     */
+    void key(const std::string& name);
+
+    void value(const std::string& str);
+    void value(const char* str) { value(std::string(str)); }
+    void value(bool b);
+    void value(double d);
+    void value(long long i);
+    void value(unsigned long long u);
+    void value(int i) { value(static_cast<long long>(i)); }
+    void value(long i) { value(static_cast<long long>(i)); }
+    void value(unsigned int u) { value(static_cast<unsigned long long>(u)); }
+    void value(unsigned long u) { value(static_cast<unsigned long long>(u)); }
+    void null();
+
+    /**
+     * Записать пару "ключ: значение"
+     */
+    template <typename T>
+    void field(const std::string& name, const T& val) {
+        key(name);
+        value(val);
+    }
+
+    /**
+     * Экранировать строку по правилам JSON (невалидный UTF-8 заменяется на U+FFFD)
+     */
+    static void escapeString(const std::string& str, std::string& out);
+
+    /**
+     * Отформатировать double так же, как nlohmann::json
+     */
+    static std::string formatDouble(double d);
+
+private:
+    struct Level {
+        bool is_array;
+        size_t count;
+    };
+
+    OutputSink& sink;
+    int indent;
+    std::vector<Level> stack;
+    bool after_key = false;
+    std::string scratch;
+
+    void beforeValue();
+    void newline(size_t depth);
+};
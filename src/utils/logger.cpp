@@ -17,8 +17,8 @@ void Logger::initialize(const std::string& log_file_path,
     try {
         std::vector<spdlog::sink_ptr> sinks;
 
-        // Console sink (всегда есть)
-        auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        // Console sink (всегда есть), в stderr - stdout остается только для отчетов
+        auto console_sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
         console_sink->set_level(level);
         sinks.push_back(console_sink);
 
@@ -42,7 +42,13 @@ void Logger::initialize(const std::string& log_file_path,
 }
 
 void Logger::setLevel(spdlog::level::level_enum level) {
-    if (instance) {
-        instance->set_level(level);
+    if (!instance) {
+        initialize("", level);
+        return;
+    }
+    // у sink'ов свой уровень с момента initialize
+    for (auto& sink : instance->sinks()) {
+        sink->set_level(level);
     }
+    instance->set_level(level);
 }
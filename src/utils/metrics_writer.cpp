@@ -0,0 +1,154 @@
+#include "utils/metrics_writer.h"
+#include "utils/logger.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char* PREFIX = "secret_detector_scan_";
+
+    std::string formatValue(double value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.9g", value);
+        return buf;
+    }
+
+    std::string formatValue(uint64_t value) {
+        return std::to_string(value);
+    }
+
+    /**
+     * Заголовок метрики: # HELP и # TYPE
+     */
+    void writeHeader(OutputSink& sink, const std::string& name, const std::string& help) {
+        sink.write("# HELP " + std::string(PREFIX) + name + " " + help + "\n");
+        sink.write("# TYPE " + std::string(PREFIX) + name + " gauge\n");
+    }
+
+    template <typename T>
+    void writeSample(OutputSink& sink, const std::string& name, const std::string& labels, T value) {
+        std::string line = PREFIX + name;
+        if (!labels.empty()) {
+            line += "{" + labels + "}";
+        }
+        line += " " + formatValue(value) + "\n";
+        sink.write(line);
+    }
+
+    template <typename T>
+    void writeGauge(OutputSink& sink, const std::string& name, const std::string& help, T value) {
+        writeHeader(sink, name, help);
+        writeSample(sink, name, "", value);
+    }
+}
+
+void MetricsWriter::write(const ScanStatistics& statistics, OutputSink& sink) {
+    writeGauge(sink, "files", "Files scanned by the last scan.",
+               static_cast<uint64_t>(statistics.total_files_scanned));
+    writeGauge(sink, "duplicate_files", "Duplicate files whose findings were copied without rescanning.",
+               static_cast<uint64_t>(statistics.duplicate_files));
+    writeGauge(sink, "bytes", "Bytes read and matched by the last scan.",
+               statistics.total_bytes_scanned);
+    writeGauge(sink, "lines", "Lines scanned by the last scan.",
+               static_cast<uint64_t>(statistics.total_lines_scanned));
+
+    writeGauge(sink, "matches", "Findings reported by the last scan.",
+               static_cast<uint64_t>(statistics.total_matches_found));
+    writeGauge(sink, "baseline_suppressed", "Findings suppressed by the baseline.",
+               static_cast<uint64_t>(statistics.baseline_suppressed));
+    // окна из-за длинных строк - не превышение бюджета, считаются отдельно
+    writeHeader(sink, "partial_files", "Files not scanned as a whole, by cause: long_lines (lines over "
+                "--max-line-length scanned in windows), time_budget (per-file time budget exceeded), "
+                "cancelled.");
+    for (PartialCause cause : {PartialCause::LongLines, PartialCause::TimeBudget, PartialCause::Cancelled}) {
+        writeSample(sink, "partial_files", "cause=\"" + partialCauseName(cause) + "\"",
+                    static_cast<uint64_t>(statistics.partialCount(cause)));
+    }
+
+    writeHeader(sink, "severity_matches", "Findings by severity.");
+    writeSample(sink, "severity_matches", "severity=\"critical\"",
+                static_cast<uint64_t>(statistics.critical_count));
+    writeSample(sink, "severity_matches", "severity=\"high\"",
+                static_cast<uint64_t>(statistics.high_count));
+    writeSample(sink, "severity_matches", "severity=\"medium\"",
+                static_cast<uint64_t>(statistics.medium_count));
+    writeSample(sink, "severity_matches", "severity=\"low\"",
+                static_cast<uint64_t>(statistics.low_count));
+
+    if (!statistics.pattern_counts.empty()) {
+        writeHeader(sink, "pattern_matches", "Findings by pattern.");
+        for (const auto& [pattern, count] : statistics.pattern_counts) {
+            writeSample(sink, "pattern_matches", "pattern=\"" + escapeLabel(pattern) + "\"",
+                        static_cast<uint64_t>(count));
+        }
+    }
+
+    writeGauge(sink, "duration_seconds", "Wall clock duration of the last scan.",
+               statistics.scan_time_seconds);
+
+    // чтение и поиск суммируются по потокам и могут превышать длительность сканирования
+    writeHeader(sink, "phase_seconds",
+                "Time per scan phase; read and match are summed over worker threads.");
+    writeSample(sink, "phase_seconds", "phase=\"walk\"", statistics.walk_time_seconds);
+    writeSample(sink, "phase_seconds", "phase=\"read\"", statistics.read_time_seconds);
+    writeSample(sink, "phase_seconds", "phase=\"match\"", statistics.match_time_seconds);
+    writeSample(sink, "phase_seconds", "phase=\"export\"", statistics.export_time_seconds);
+
+    writeGauge(sink, "peak_rss_bytes", "Peak resident set size of the scanner process.",
+               statistics.peak_rss_bytes);
+    writeGauge(sink, "threads", "Worker threads used by the last scan.",
+               static_cast<uint64_t>(statistics.threads_used));
+    writeGauge(sink, "thread_utilization_ratio",
+               "Share of worker thread time spent processing files (0..1).",
+               statistics.threadUtilization());
+
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    writeGauge(sink, "timestamp_seconds", "Unix time when the last scan finished.",
+               static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(now).count()));
+}
+
+bool MetricsWriter::writeTextfile(const ScanStatistics& statistics, const std::string& path) {
+    try {
+        // node_exporter читает только *.prom - временный файл он не увидит
+        std::string tmp_path = path + ".tmp";
+        {
+            auto sink = FileSink::open(tmp_path);
+            if (!sink) {
+                LOG_ERROR_FMT("Cannot open file for writing: {}", tmp_path);
+                return false;
+            }
+            write(statistics, *sink);
+            sink->flush();
+            if (sink->failed()) {
+                LOG_ERROR_FMT("Error writing metrics: {}", tmp_path);
+                return false;
+            }
+        }
+        fs::rename(tmp_path, path);
+
+        LOG_INFO_FMT("Metrics written: {}", path);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_FMT("Error writing metrics: {}", e.what());
+        return false;
+    }
+}
+
+std::string MetricsWriter::escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '"') {
+            escaped += "\\\"";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
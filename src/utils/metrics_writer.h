@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include "core/file_scanner.h"
+#include "utils/output_sink.h"
+
+/**
+ * @class MetricsWriter
+ * @brief Метрики сканирования в текстовом формате Prometheus
+ *
+ * Файл рассчитан на textfile collector node_exporter: все метрики - gauge
+ * с префиксом secret_detector_scan_, описывают последнее сканирование.
+ */
+class MetricsWriter {
+public:
+    /**
+     * Записать метрики в приемник
+     * @param statistics Статистика сканирования
+     * @param sink Приемник данных
+     */
+    static void write(const ScanStatistics& statistics, OutputSink& sink);
+
+    /**
+     * Записать файл метрик атомарно (временный файл и rename в той же директории),
+     * чтобы node_exporter не прочитал его наполовину записанным
+     * @param statistics Статистика сканирования
+     * @param path Путь до файла (обычно *.prom в --collector.textfile.directory)
+     * @return true если успешно
+     */
+    static bool writeTextfile(const ScanStatistics& statistics, const std::string& path);
+
+    /**
+     * Экранировать значение label'а (\, " и перевод строки)
+     */
+    static std::string escapeLabel(const std::string& value);
+};
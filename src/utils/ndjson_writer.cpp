@@ -0,0 +1,91 @@
+#include "utils/ndjson_writer.h"
+#include "utils/json_stream_writer.h"
+
+NdjsonWriter::NdjsonWriter(OutputSink& s) : sink(s) {}
+
+void NdjsonWriter::writeFinding(const Match& match) {
+    writeMatch("finding", match);
+}
+
+void NdjsonWriter::writeResolved(const Match& match) {
+    writeMatch("resolved", match);
+}
+
+void NdjsonWriter::writeMatch(const char* type, const Match& match) {
+    StringSink line;
+    JsonStreamWriter writer(line, -1);
+
+    writer.beginObject();
+    writer.field("type", type);
+    writer.field("file_path", match.file_path);
+    writer.field("line_number", match.line_number);
+    writer.field("column_number", match.column_number);
+    writer.field("severity", match.severity);
+    writer.field("pattern_name", match.pattern_name);
+    writer.field("matched_text", match.matched_text);
+    writer.field("preview", match.preview);
+    if (match.entropy > 0) {
+        writer.field("entropy", match.entropy);
+    }
+    if (!match.commit.empty()) {
+        writer.field("commit", match.commit);
+    }
+    writer.endObject();
+    line.write("\n", 1);
+
+    writeLine(line.str());
+}
+
+void NdjsonWriter::writeSummary(const ScanStatistics& statistics, bool has_critical, bool has_high) {
+    StringSink line;
+    JsonStreamWriter writer(line, -1);
+
+    writer.beginObject();
+    writer.field("type", "summary");
+    writer.field("total_files", statistics.total_files_scanned);
+    writer.field("total_lines", statistics.total_lines_scanned);
+    writer.field("total_matches", statistics.total_matches_found);
+    writer.field("critical", statistics.critical_count);
+    writer.field("high", statistics.high_count);
+    writer.field("medium", statistics.medium_count);
+    writer.field("low", statistics.low_count);
+    writer.field("scan_time_seconds", statistics.scan_time_seconds);
+    if (statistics.baseline_suppressed > 0) {
+        writer.field("baseline_suppressed", statistics.baseline_suppressed);
+    }
+    if (!statistics.partial_files.empty()) {
+        writer.field("partial_files", statistics.partial_files.size());
+    }
+    if (statistics.cancelled) {
+        writer.field("cancelled", true);
+    }
+    writer.field("has_critical", has_critical);
+    writer.field("has_high", has_high);
+    writer.endObject();
+    line.write("\n", 1);
+
+    writeLine(line.str());
+}
+
+void NdjsonWriter::writeUpdate(const WatchUpdate& update) {
+    StringSink line;
+    JsonStreamWriter writer(line, -1);
+
+    writer.beginObject();
+    writer.field("type", "update");
+    writer.field("added", update.added.size());
+    writer.field("removed", update.removed.size());
+    writer.field("files_rescanned", update.files_rescanned);
+    writer.field("files_removed", update.files_removed);
+    writer.field("total_findings", update.total_findings);
+    writer.endObject();
+    line.write("\n", 1);
+
+    writeLine(line.str());
+}
+
+void NdjsonWriter::writeLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    sink.write(line);
+    sink.flush();
+}
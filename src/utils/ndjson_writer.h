@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <mutex>
+#include "core/secret_detector.h"
+#include "core/watch_update.h"
+#include "utils/output_sink.h"
+
+/**
+ * @class NdjsonWriter
+ * @brief Вывод находок в формате NDJSON (один JSON объект на строку)
+ *
+ * Каждая находка записывается и сбрасывается сразу после подтверждения,
+ * в конце пишется запись со сводкой. Методы потокобезопасны: строка
+ * формируется в вызывающем потоке, в приемник пишется целиком под мьютексом,
+ * поэтому строки от разных потоков не перемешиваются.
+ */
+class NdjsonWriter {
+public:
+    explicit NdjsonWriter(OutputSink& sink);
+    ~NdjsonWriter() = default;
+
+    /**
+     * Записать находку: {"type":"finding", ...}
+     */
+    void writeFinding(const Match& match);
+
+    /**
+     * Записать итоговую сводку: {"type":"summary", ...}
+     */
+    void writeSummary(const ScanStatistics& statistics, bool has_critical, bool has_high);
+
+    /**
+     * Записать исчезнувшую находку (режим наблюдения): {"type":"resolved", ...}
+     */
+    void writeResolved(const Match& match);
+
+    /**
+     * Записать итог пачки изменений (режим наблюдения): {"type":"update", ...}
+     */
+    void writeUpdate(const WatchUpdate& update);
+
+private:
+    OutputSink& sink;
+    std::mutex write_mutex;
+
+    void writeMatch(const char* type, const Match& match);
+    void writeLine(const std::string& line);
+};
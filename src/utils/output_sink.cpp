@@ -0,0 +1,140 @@
+#include "utils/output_sink.h"
+#include <chrono>
+
+FileSink::FileSink(std::FILE* f, bool owns, size_t buffer_size)
+    : file(f), owns_file(owns), capacity(buffer_size) {
+    buffer.reserve(capacity);
+}
+
+FileSink::~FileSink() {
+    flush();
+    if (owns_file && file) {
+        std::fclose(file);
+    }
+}
+
+std::unique_ptr<FileSink> FileSink::open(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        return nullptr;
+    }
+    return std::make_unique<FileSink>(f, true);
+}
+
+void FileSink::write(const char* data, size_t size) {
+    // большие блоки пишутся напрямую, мелкие копятся в буфере
+    if (buffer.size() + size > capacity) {
+        flush();
+        if (size >= capacity) {
+            if (std::fwrite(data, 1, size, file) != size) {
+                error = true;
+            }
+            return;
+        }
+    }
+    buffer.append(data, size);
+}
+
+void FileSink::flush() {
+    if (!file) {
+        return;
+    }
+    if (!buffer.empty()) {
+        if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+            error = true;
+        }
+        buffer.clear();
+    }
+    if (std::fflush(file) != 0) {
+        error = true;
+    }
+}
+
+AsyncSink::AsyncSink(std::unique_ptr<OutputSink> t, size_t buffer_size)
+    : target(std::move(t)), capacity(buffer_size) {
+    pending.reserve(capacity);
+    writing.reserve(capacity);
+    writer = std::thread(&AsyncSink::run, this);
+}
+
+AsyncSink::~AsyncSink() {
+    close();
+}
+
+void AsyncSink::write(const char* data, size_t size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (closed) {
+        target->write(data, size);
+        error = target->failed();
+        return;
+    }
+
+    // писатель отстал на несколько блоков - подождать, а не копить без предела
+    space_cv.wait(lock, [this] { return pending.size() < 4 * capacity || stopping; });
+
+    pending.append(data, size);
+    if (pending.size() >= capacity) {
+        work_cv.notify_one();
+    }
+}
+
+void AsyncSink::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closed) {
+        target->flush();
+        error = target->failed();
+        return;
+    }
+    flush_requested = true;
+    work_cv.notify_one();
+}
+
+void AsyncSink::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed) {
+            return;
+        }
+        stopping = true;
+    }
+    work_cv.notify_one();
+    writer.join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+}
+
+void AsyncSink::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_cv.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [this] {
+            return stopping || flush_requested || pending.size() >= capacity;
+        });
+
+        if (pending.empty()) {
+            flush_requested = false;
+            if (stopping) {
+                break;
+            }
+            continue;
+        }
+
+        writing.swap(pending);
+        flush_requested = false;
+        space_cv.notify_all();
+
+        // запись - вне блокировки, производители в это время продолжают работу
+        lock.unlock();
+        target->write(writing.data(), writing.size());
+        target->flush();
+        if (target->failed()) {
+            error = true;
+        }
+        writing.clear();
+        lock.lock();
+    }
+    target->flush();
+    if (target->failed()) {
+        error = true;
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/**
+ * @class OutputSink
+ * @brief Приемник выходных данных (файл, stdout) для потоковых writer'ов
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    /**
+     * Записать блок данных
+     */
+    virtual void write(const char* data, size_t size) = 0;
+
+    /**
+     * Записать строку
+     */
+    void write(const std::string& str) { write(str.data(), str.size()); }
+
+    /**
+     * Сбросить буферы в файл
+     */
+    virtual void flush() = 0;
+
+    /**
+     * Были ли ошибки записи
+     */
+    virtual bool failed() const = 0;
+};
+
+/**
+ * @class FileSink
+ * @brief Буферизированная запись в FILE* (файл или stdout)
+ */
+class FileSink : public OutputSink {
+public:
+    /**
+     * @param file Открытый файл
+     * @param owns_file Закрыть файл в деструкторе
+     * @param buffer_size Размер внутреннего буфера
+     */
+    explicit FileSink(std::FILE* file, bool owns_file = false, size_t buffer_size = 256 * 1024);
+    ~FileSink() override;
+
+    /**
+     * Открыть файл для записи
+     * @return nullptr если файл не удалось открыть
+     */
+    static std::unique_ptr<FileSink> open(const std::string& path);
+
+    void write(const char* data, size_t size) override;
+    using OutputSink::write;
+    void flush() override;
+    bool failed() const override { return error; }
+
+private:
+    std::FILE* file;
+    bool owns_file;
+    std::string buffer;
+    size_t capacity;
+    bool error = false;
+};
+
+/**
+ * @class StringSink
+ * @brief Запись в строку в памяти
+ */
+class StringSink : public OutputSink {
+public:
+    void write(const char* data, size_t size) override { buffer.append(data, size); }
+    using OutputSink::write;
+    void flush() override {}
+    bool failed() const override { return false; }
+
+    const std::string& str() const { return buffer; }
+    void clear() { buffer.clear(); }
+
+private:
+    std::string buffer;
+};
+
+/**
+ * @class AsyncSink
+ * @brief Асинхронная запись через отдельный поток-писатель
+ *
+ * Потоки сканирования только дописывают данные в буфер под мьютексом,
+ * системные вызовы записи делает поток-писатель крупными блоками.
+ * Накопленные данные уходят в целевой приемник, когда буфер заполнен,
+ * по flush() или не позже чем через FLUSH_INTERVAL_MS. Если писатель
+ * не успевает (медленный pipe), write() ждет - память ограничена.
+ */
+class AsyncSink : public OutputSink {
+public:
+    static constexpr int FLUSH_INTERVAL_MS = 50;
+
+    /**
+     * @param target Целевой приемник (пишется только из потока-писателя)
+     * @param buffer_size Размер блока, после которого данные отдаются писателю
+     */
+    explicit AsyncSink(std::unique_ptr<OutputSink> target, size_t buffer_size = 1024 * 1024);
+    ~AsyncSink() override;
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    void write(const char* data, size_t size) override;
+    using OutputSink::write;
+
+    /**
+     * Отдать накопленные данные писателю (не ждет окончания записи)
+     */
+    void flush() override;
+
+    bool failed() const override { return error; }
+
+    /**
+     * Дописать все данные, сбросить целевой приемник и остановить писатель.
+     * После close() запись идет напрямую в целевой приемник.
+     */
+    void close();
+
+private:
+    std::unique_ptr<OutputSink> target;
+    size_t capacity;
+
+    std::string pending;        ///< Заполняется производителями
+    std::string writing;        ///< Принадлежит потоку-писателю
+    bool flush_requested = false;
+    bool stopping = false;
+    bool closed = false;
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable space_cv;
+    std::thread writer;
+    std::atomic<bool> error{false};
+
+    void run();
+};
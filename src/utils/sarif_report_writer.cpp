@@ -0,0 +1,223 @@
+#include "utils/sarif_report_writer.h"
+#include "utils/hash_utils.h"
+#include <cctype>
+
+namespace {
+    const char* SARIF_SCHEMA = "https://json.schemastore.org/sarif-2.1.0.json";
+    const char* TOOL_URI = "https://github.com/CHIKENlvl19/SecretDetector";
+
+    // оценка для security-severity (шкала GitHub code scanning 0.0 - 10.0)
+    const char* securitySeverity(const std::string& severity) {
+        if (severity == "CRITICAL") return "9.5";
+        if (severity == "HIGH") return "7.5";
+        if (severity == "MEDIUM") return "5.0";
+        return "2.0";
+    }
+}
+
+SarifReportWriter::SarifReportWriter(OutputSink& s, const std::vector<Pattern>& p, int indent)
+    : sink(s), writer(s, indent), patterns(p) {
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        rule_index.emplace(patterns[i].name, i);
+    }
+}
+
+void SarifReportWriter::begin() {
+    writer.beginObject();
+    writer.field("$schema", SARIF_SCHEMA);
+    writer.field("version", "2.1.0");
+    writer.key("runs");
+    writer.beginArray();
+    writer.beginObject();
+
+    writer.key("tool");
+    writer.beginObject();
+    writer.key("driver");
+    writer.beginObject();
+    writer.field("name", "SecretDetector");
+    writer.field("version", VERSION);
+    writer.field("informationUri", TOOL_URI);
+
+    writer.key("rules");
+    writer.beginArray();
+    for (const auto& pattern : patterns) {
+        writer.beginObject();
+        writer.field("id", pattern.name);
+        writer.field("name", pattern.name);
+        writer.key("shortDescription");
+        writer.beginObject();
+        writer.field("text", pattern.description.empty() ? pattern.name : pattern.description);
+        writer.endObject();
+        writer.key("defaultConfiguration");
+        writer.beginObject();
+        writer.field("level", toLevel(pattern.severity));
+        writer.endObject();
+        writer.key("properties");
+        writer.beginObject();
+        writer.field("severity", pattern.severity);
+        writer.field("security-severity", securitySeverity(pattern.severity));
+        writer.key("tags");
+        writer.beginArray();
+        writer.value("security");
+        writer.value("secret");
+        writer.endArray();
+        writer.endObject();
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();  // driver
+    writer.endObject();  // tool
+
+    writer.key("results");
+    writer.beginArray();
+}
+
+void SarifReportWriter::writeMatch(const Match& match) {
+    writer.beginObject();
+    writer.field("ruleId", match.pattern_name);
+    auto it = rule_index.find(match.pattern_name);
+    if (it != rule_index.end()) {
+        writer.field("ruleIndex", it->second);
+    }
+    writer.field("level", toLevel(match.severity));
+
+    // сам секрет в сообщение не попадает - только тип и место
+    writer.key("message");
+    writer.beginObject();
+    writer.field("text", "Potential secret (" + match.pattern_name + ") detected");
+    writer.endObject();
+
+    writer.key("locations");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("physicalLocation");
+    writer.beginObject();
+    writer.key("artifactLocation");
+    writer.beginObject();
+    writer.field("uri", toUri(match.file_path));
+    writer.endObject();
+    writer.key("region");
+    writer.beginObject();
+    writer.field("startLine", match.line_number);
+    writer.field("startColumn", match.column_number);
+    writer.field("endColumn", match.column_number + match.matched_text.size());
+    writer.endObject();
+    writer.endObject();
+    writer.endObject();
+    writer.endArray();
+
+    // стабильный отпечаток для дедупликации находок между запусками
+    writer.key("partialFingerprints");
+    writer.beginObject();
+    writer.field("secretHash/v1",
+                 HashUtils::toHex(HashUtils::hash64(match.pattern_name + '\0' + match.matched_text)));
+    writer.endObject();
+
+    if (!match.commit.empty() || match.entropy > 0) {
+        writer.key("properties");
+        writer.beginObject();
+        if (!match.commit.empty()) {
+            writer.field("commit", match.commit);
+        }
+        if (match.entropy > 0) {
+            writer.field("entropy", match.entropy);
+        }
+        writer.endObject();
+    }
+
+    writer.endObject();
+}
+
+void SarifReportWriter::finish(const ScanStatistics& statistics) {
+    writer.endArray();  // results
+
+    writer.key("invocations");
+    writer.beginArray();
+    writer.beginObject();
+    writer.field("executionSuccessful", true);
+    writer.key("properties");
+    writer.beginObject();
+    writer.field("total_files_scanned", statistics.total_files_scanned);
+    writer.field("total_lines_scanned", statistics.total_lines_scanned);
+    writer.field("scan_time_seconds", statistics.scan_time_seconds);
+    writer.endObject();
+    // частично просканированные файлы - находки в них могут быть неполными
+    if (!statistics.partial_files.empty()) {
+        writer.key("toolExecutionNotifications");
+        writer.beginArray();
+        for (const auto& partial : statistics.partial_files) {
+            writer.beginObject();
+            writer.field("level", "warning");
+            writer.key("message");
+            writer.beginObject();
+            writer.field("text", "File scanned partially: " + partial.reason);
+            writer.endObject();
+            writer.key("locations");
+            writer.beginArray();
+            writer.beginObject();
+            writer.key("physicalLocation");
+            writer.beginObject();
+            writer.key("artifactLocation");
+            writer.beginObject();
+            writer.field("uri", toUri(partial.file_path));
+            writer.endObject();
+            writer.endObject();
+            writer.endObject();
+            writer.endArray();
+            writer.endObject();
+        }
+        writer.endArray();
+    }
+    writer.endObject();
+    writer.endArray();
+
+    writer.endObject();  // run
+    writer.endArray();   // runs
+    writer.endObject();
+    sink.write("\n", 1);
+    sink.flush();
+}
+
+void SarifReportWriter::write(const ScanResult& result, const std::vector<Pattern>& patterns,
+                              OutputSink& sink, int indent) {
+    SarifReportWriter report(sink, patterns, indent);
+    report.begin();
+    for (const auto& match : result.matches) {
+        report.writeMatch(match);
+    }
+    report.finish(result.statistics);
+}
+
+const char* SarifReportWriter::toLevel(const std::string& severity) {
+    if (severity == "CRITICAL" || severity == "HIGH") return "error";
+    if (severity == "MEDIUM") return "warning";
+    return "note";
+}
+
+std::string SarifReportWriter::toUri(const std::string& path) {
+    static const char* HEX = "0123456789ABCDEF";
+
+    std::string source = path;
+    if (source.rfind("./", 0) == 0) {
+        source.erase(0, 2);
+    }
+
+    std::string uri;
+    uri.reserve(source.size() + 8);
+    if (!source.empty() && source[0] == '/') {
+        uri = "file://";
+    }
+
+    // процентное кодирование всего, кроме unreserved символов и '/'
+    for (unsigned char c : source) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/') {
+            uri += static_cast<char>(c);
+        } else {
+            uri += '%';
+            uri += HEX[c >> 4];
+            uri += HEX[c & 0x0F];
+        }
+    }
+    return uri;
+}
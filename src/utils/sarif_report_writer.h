@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "core/secret_detector.h"
+#include "utils/json_stream_writer.h"
+
+/**
+ * @class SarifReportWriter
+ * @brief Потоковая запись отчета в формате SARIF 2.1.0
+ *
+ * Таблица rules[] пишется один раз из списка паттернов, находки ссылаются
+ * на правило по ruleIndex. Массив results[] пишется по мере поступления
+ * находок, поэтому память не зависит от их количества.
+ */
+class SarifReportWriter {
+public:
+    /**
+     * @param sink Приемник данных
+     * @param patterns Паттерны детектора (таблица правил)
+     * @param indent Отступ (как у json::dump)
+     */
+    SarifReportWriter(OutputSink& sink, const std::vector<Pattern>& patterns, int indent = 2);
+    ~SarifReportWriter() = default;
+
+    /**
+     * Начать отчет: заголовок, описание инструмента, таблица правил
+     */
+    void begin();
+
+    /**
+     * Записать одну находку
+     */
+    void writeMatch(const Match& match);
+
+    /**
+     * Завершить отчет (закрыть results и run)
+     */
+    void finish(const ScanStatistics& statistics);
+
+    /**
+     * Записать готовый результат целиком
+     */
+    static void write(const ScanResult& result, const std::vector<Pattern>& patterns,
+                      OutputSink& sink, int indent = 2);
+
+    /**
+     * Уровень SARIF для severity: error, warning, note
+     */
+    static const char* toLevel(const std::string& severity);
+
+    /**
+     * Путь к файлу в виде URI для artifactLocation
+     */
+    static std::string toUri(const std::string& path);
+
+private:
+    OutputSink& sink;
+    JsonStreamWriter writer;
+    const std::vector<Pattern>& patterns;
+    std::unordered_map<std::string, size_t> rule_index;
+};
@@ -0,0 +1,185 @@
+#include "utils/trace_recorder.h"
+#include "utils/json_stream_writer.h"
+#include "utils/output_sink.h"
+#include "utils/logger.h"
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+std::atomic<bool> TraceRecorder::active{false};
+
+namespace {
+    /**
+     * Кольцевой буфер одного потока (пишет только сам поток)
+     */
+    struct ThreadBuffer {
+        std::vector<TraceEvent> events;
+        std::atomic<uint64_t> written{0};   ///< Всего записано (позиция = written % size)
+        uint32_t tid = 0;
+        std::string name;
+    };
+
+    std::mutex registry_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;     // переживают свои потоки
+    size_t buffer_capacity = 0;
+    std::chrono::steady_clock::time_point epoch;
+    std::atomic<uint64_t> generation{0};                    // меняется при start/writeFile
+
+    thread_local std::shared_ptr<ThreadBuffer> local_buffer;
+    thread_local uint64_t local_generation = 0;
+
+    ThreadBuffer& threadBuffer() {
+        uint64_t current = generation.load(std::memory_order_acquire);
+        if (!local_buffer || local_generation != current) {
+            auto buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            buffer->events.resize(buffer_capacity);
+            buffer->tid = static_cast<uint32_t>(buffers.size() + 1);
+            buffer->name = buffer->tid == 1 ? "main" : "thread " + std::to_string(buffer->tid);
+            buffers.push_back(buffer);
+            local_buffer = std::move(buffer);
+            local_generation = current;
+        }
+        return *local_buffer;
+    }
+
+    void copyDetail(const std::string& detail, char (&out)[TraceEvent::DETAIL_SIZE]) {
+        // для путей важнее конец - обрезается начало
+        constexpr size_t max_length = TraceEvent::DETAIL_SIZE - 1;
+        if (detail.size() <= max_length) {
+            std::memcpy(out, detail.data(), detail.size());
+            out[detail.size()] = '\0';
+            return;
+        }
+        std::memcpy(out, "...", 3);
+        std::memcpy(out + 3, detail.data() + detail.size() - (max_length - 3), max_length - 3);
+        out[max_length] = '\0';
+    }
+}
+
+void TraceRecorder::start(size_t events_per_thread) {
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        buffers.clear();
+        buffer_capacity = std::max<size_t>(events_per_thread, 1);
+        epoch = std::chrono::steady_clock::now();
+        generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    active.store(true, std::memory_order_release);
+    // вызывающий поток - первый на шкале
+    threadBuffer();
+}
+
+uint64_t TraceRecorder::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void TraceRecorder::record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+                           const std::string* detail) {
+    if (!enabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer.events[index % buffer.events.size()];
+    event.name = name;
+    event.category = category;
+    event.start_ns = start_ns;
+    event.duration_ns = end_ns > start_ns ? end_ns - start_ns : 0;
+    if (detail) {
+        copyDetail(*detail, event.detail);
+    } else {
+        event.detail[0] = '\0';
+    }
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::setThreadName(const std::string& name) {
+    if (!enabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer.name = name;
+}
+
+bool TraceRecorder::writeFile(const std::string& path) {
+    active.store(false, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto sink = FileSink::open(path);
+    if (!sink) {
+        LOG_ERROR_FMT("Cannot open trace file: {}", path);
+        return false;
+    }
+
+    const long long pid = static_cast<long long>(::getpid());
+    uint64_t dropped = 0;
+    size_t total = 0;
+
+    JsonStreamWriter writer(*sink, -1);
+    writer.beginObject();
+    writer.field("displayTimeUnit", "ms");
+    writer.key("traceEvents");
+    writer.beginArray();
+    for (const auto& buffer : buffers) {
+        writer.beginObject();
+        writer.key("args");
+        writer.beginObject();
+        writer.field("name", buffer->name);
+        writer.endObject();
+        writer.field("name", "thread_name");
+        writer.field("ph", "M");
+        writer.field("pid", pid);
+        writer.field("tid", buffer->tid);
+        writer.endObject();
+
+        // от самого старого сохранившегося интервала к новому
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t capacity = buffer->events.size();
+        uint64_t first = written > capacity ? written - capacity : 0;
+        dropped += first;
+        for (uint64_t i = first; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % capacity];
+            writer.beginObject();
+            if (event.detail[0] != '\0') {
+                writer.key("args");
+                writer.beginObject();
+                writer.field("detail", std::string(event.detail));
+                writer.endObject();
+            }
+            writer.field("cat", event.category);
+            writer.field("dur", event.duration_ns / 1000.0);
+            writer.field("name", event.name);
+            writer.field("ph", "X");
+            writer.field("pid", pid);
+            writer.field("tid", buffer->tid);
+            writer.field("ts", event.start_ns / 1000.0);
+            writer.endObject();
+            ++total;
+        }
+    }
+    writer.endArray();
+    writer.key("otherData");
+    writer.beginObject();
+    writer.field("dropped_events", dropped);
+    writer.endObject();
+    writer.endObject();
+    sink->write("\n", 1);
+    sink->flush();
+
+    // следующий start начнет с чистых буферов
+    buffers.clear();
+    generation.fetch_add(1, std::memory_order_acq_rel);
+
+    if (sink->failed()) {
+        LOG_ERROR_FMT("Failed to write trace file: {}", path);
+        return false;
+    }
+    LOG_INFO_FMT("Trace with {} spans written to {} ({} oldest dropped)", total, path, dropped);
+    return true;
+}
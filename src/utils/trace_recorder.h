@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct TraceEvent
+ * @brief Один завершенный интервал (span) в буфере потока
+ */
+struct TraceEvent {
+    static constexpr size_t DETAIL_SIZE = 64;
+
+    const char* name = nullptr;         ///< Имя интервала (строковый литерал)
+    const char* category = nullptr;     ///< Категория (строковый литерал)
+    uint64_t start_ns = 0;              ///< Начало от запуска записи
+    uint64_t duration_ns = 0;
+    char detail[DETAIL_SIZE] = {};      ///< Путь файла / имя паттерна (обрезается слева)
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Запись временной шкалы сканирования в формате Chrome trace-event
+ *
+ * Каждый поток пишет интервалы в свой кольцевой буфер фиксированного
+ * размера без блокировок: блокировка берется один раз, при регистрации
+ * буфера потока. При переполнении самые старые интервалы затираются.
+ * Буферы сбрасываются в файл в конце (writeFile), когда рабочие потоки
+ * уже завершены. Файл открывается в chrome://tracing и ui.perfetto.dev.
+ * Пока запись не включена, TRACE_SCOPE стоит одну атомарную загрузку.
+ */
+class TraceRecorder {
+public:
+    /**
+     * Включить запись
+     * @param events_per_thread Размер кольцевого буфера каждого потока
+     */
+    static void start(size_t events_per_thread = 32768);
+
+    /**
+     * Включена ли запись
+     */
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * Текущее время от запуска записи, нс
+     */
+    static uint64_t now();
+
+    /**
+     * Записать интервал текущего потока
+     * @param name Имя (строковый литерал - указатель хранится в буфере)
+     * @param category Категория (строковый литерал)
+     * @param detail Подробность (копируется, nullptr - нет)
+     */
+    static void record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns,
+                       const std::string* detail = nullptr);
+
+    /**
+     * Имя текущего потока на временной шкале
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * Остановить запись и сохранить trace-event JSON
+     * Вызывается после завершения рабочих потоков.
+     * @return true если файл записан
+     */
+    static bool writeFile(const std::string& path);
+
+private:
+    static std::atomic<bool> active;
+};
+
+/**
+ * @class TraceScope
+ * @brief Интервал от конструктора до деструктора (используйте TRACE_SCOPE)
+ */
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category, const std::string* detail = nullptr)
+        : name(name), category(category), detail(detail),
+          recording(TraceRecorder::enabled()),
+          start_ns(recording ? TraceRecorder::now() : 0) {}
+
+    ~TraceScope() {
+        if (recording) {
+            TraceRecorder::record(name, category, start_ns, TraceRecorder::now(), detail);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    const std::string* detail;
+    bool recording;
+    uint64_t start_ns;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// интервал до конца текущего блока; detail - указатель на std::string или nullptr
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name, category)
+#define TRACE_SCOPE_DETAIL(name, category, detail) \
+    TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name, category, detail)
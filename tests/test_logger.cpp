@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "utils/logger.h"
+
+namespace {
+    /**
+     * Включает консольный лог на время теста (общий main его выключает)
+     */
+    class LoggerFixture : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            Logger::setLevel(spdlog::level::info);
+        }
+
+        void TearDown() override {
+            Logger::setLevel(spdlog::level::off);
+        }
+    };
+}
+
+TEST_F(LoggerFixture, ConsoleLogGoesToStderr) {
+    // stdout занят отчетами (--format ndjson, json без --output)
+    testing::internal::CaptureStdout();
+    testing::internal::CaptureStderr();
+    LOG_INFO("logger test message");
+    LOG_WARN_FMT("logger test warning {}", 42);
+    Logger::getInstance()->flush();
+    std::string out = testing::internal::GetCapturedStdout();
+    std::string err = testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(out, "");
+    EXPECT_NE(err.find("logger test message"), std::string::npos);
+    EXPECT_NE(err.find("logger test warning 42"), std::string::npos);
+}
+
+TEST_F(LoggerFixture, LevelFiltersConsoleOutput) {
+    Logger::setLevel(spdlog::level::warn);
+    testing::internal::CaptureStderr();
+    LOG_INFO("hidden info");
+    LOG_WARN("visible warning");
+    Logger::getInstance()->flush();
+    std::string err = testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(err.find("hidden info"), std::string::npos);
+    EXPECT_NE(err.find("visible warning"), std::string::npos);
+}
@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+#include "utils/logger.h"
+#include <cstdlib>
+
+/**
+ * Общий main тестов
+ * Логи по умолчанию выключены: предупреждения о дорогих паттернах, испорченных
+ * бандлах и отчетах тесты вызывают намеренно. SECRET_DETECTOR_TEST_LOG=debug
+ * (или info, warn, ...) включает их при отладке.
+ */
+int main(int argc, char** argv) {
+    const char* level = std::getenv("SECRET_DETECTOR_TEST_LOG");
+    Logger::initialize("", level ? spdlog::level::from_str(level) : spdlog::level::off);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "utils/metrics_writer.h"
+#include "utils/file_utils.h"
+#include "test_support.h"
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+
+namespace {
+    ScanStatistics sampleStatistics() {
+        ScanStatistics stats;
+        stats.total_files_scanned = 120;
+        stats.duplicate_files = 3;
+        stats.total_bytes_scanned = 1234567;
+        stats.total_lines_scanned = 45678;
+        stats.total_matches_found = 7;
+        stats.critical_count = 2;
+        stats.high_count = 4;
+        stats.low_count = 1;
+        stats.pattern_counts = {{"aws_key", 2}, {"generic_secret", 4}, {"weird\"na\\me\nx", 1}};
+        stats.partial_files.push_back({"dist/app.min.js", "line longer than 16384 bytes scanned in windows",
+                                       PartialCause::LongLines});
+        stats.partial_files.push_back({"dist/vendor.min.js", "line longer than 16384 bytes scanned in windows",
+                                       PartialCause::LongLines});
+        stats.partial_files.push_back({"data/huge.csv", "time budget of 10000 ms exceeded, rest scanned in windows",
+                                       PartialCause::TimeBudget});
+        stats.scan_time_seconds = 1.5;
+        stats.walk_time_seconds = 0.25;
+        stats.read_time_seconds = 0.5;
+        stats.match_time_seconds = 2.75;
+        stats.threads_used = 4;
+        stats.worker_time_seconds = 1.0;
+        stats.thread_busy_seconds = 3.0;
+        return stats;
+    }
+
+    std::string exposition(const ScanStatistics& stats) {
+        StringSink sink;
+        MetricsWriter::write(stats, sink);
+        return sink.str();
+    }
+
+    std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> result;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            result.push_back(line);
+        }
+        return result;
+    }
+
+    // имя метрики, label'ы и значение одной строки-сэмпла
+    const std::regex SAMPLE(
+        R"(^(secret_detector_scan_[a-z_]+)(\{[a-z_]+="(?:[^"\\\n]|\\[\\"n])*"\})? ([0-9.e+-]+)$)");
+
+    std::map<std::string, std::string> samples(const std::string& text) {
+        std::map<std::string, std::string> result;
+        for (const auto& line : lines(text)) {
+            std::smatch m;
+            if (std::regex_match(line, m, SAMPLE)) {
+                result[m[1].str() + m[2].str()] = m[3];
+            }
+        }
+        return result;
+    }
+}
+
+TEST(MetricsWriter, ExpositionFormatLines) {
+    std::string text = exposition(sampleStatistics());
+    ASSERT_FALSE(text.empty());
+    EXPECT_EQ(text.back(), '\n');
+
+    for (const auto& line : lines(text)) {
+        SCOPED_TRACE(line);
+        if (line.rfind("# HELP ", 0) == 0) {
+            EXPECT_TRUE(std::regex_match(line, std::regex(R"(# HELP secret_detector_scan_[a-z_]+ \S.*)")));
+        } else if (line.rfind("# TYPE ", 0) == 0) {
+            EXPECT_TRUE(std::regex_match(line, std::regex(R"(# TYPE secret_detector_scan_[a-z_]+ gauge)")));
+        } else {
+            EXPECT_TRUE(std::regex_match(line, SAMPLE));
+        }
+    }
+}
+
+TEST(MetricsWriter, OneTypePerFamilyBeforeItsSamples) {
+    std::string text = exposition(sampleStatistics());
+
+    std::map<std::string, int> types;
+    std::map<std::string, int> helps;
+    std::set<std::string> finished;   // у семейства начались сэмплы другого
+    std::string current;
+    for (const auto& line : lines(text)) {
+        SCOPED_TRACE(line);
+        std::istringstream words(line);
+        std::string hash, kind, name;
+        if (line[0] == '#') {
+            words >> hash >> kind >> name;
+            (kind == "TYPE" ? types : helps)[name]++;
+            EXPECT_EQ(finished.count(name), 0u);
+            continue;
+        }
+        std::smatch m;
+        ASSERT_TRUE(std::regex_match(line, m, SAMPLE));
+        name = m[1];
+        // сэмплы семейства идут подряд, сразу после его HELP и TYPE
+        EXPECT_EQ(types[name], 1);
+        EXPECT_EQ(helps[name], 1);
+        if (name != current) {
+            EXPECT_EQ(finished.count(name), 0u);
+            if (!current.empty()) {
+                finished.insert(current);
+            }
+            current = name;
+        }
+    }
+    for (const auto& [name, count] : types) {
+        EXPECT_EQ(count, 1) << name;
+    }
+    EXPECT_GT(types.size(), 10u);
+}
+
+TEST(MetricsWriter, Values) {
+    auto values = samples(exposition(sampleStatistics()));
+    EXPECT_EQ(values["secret_detector_scan_files"], "120");
+    EXPECT_EQ(values["secret_detector_scan_duplicate_files"], "3");
+    EXPECT_EQ(values["secret_detector_scan_bytes"], "1234567");
+    EXPECT_EQ(values["secret_detector_scan_matches"], "7");
+    EXPECT_EQ(values["secret_detector_scan_severity_matches{severity=\"critical\"}"], "2");
+    EXPECT_EQ(values["secret_detector_scan_severity_matches{severity=\"medium\"}"], "0");
+    EXPECT_EQ(values["secret_detector_scan_pattern_matches{pattern=\"aws_key\"}"], "2");
+    EXPECT_EQ(values["secret_detector_scan_phase_seconds{phase=\"match\"}"], "2.75");
+    EXPECT_EQ(values["secret_detector_scan_duration_seconds"], "1.5");
+    EXPECT_EQ(values["secret_detector_scan_threads"], "4");
+    // длинные строки не считаются превышением бюджета
+    EXPECT_EQ(values["secret_detector_scan_partial_files{cause=\"long_lines\"}"], "2");
+    EXPECT_EQ(values["secret_detector_scan_partial_files{cause=\"time_budget\"}"], "1");
+    EXPECT_EQ(values["secret_detector_scan_partial_files{cause=\"cancelled\"}"], "0");
+    EXPECT_EQ(values["secret_detector_scan_thread_utilization_ratio"], "0.75");
+
+    // без находок семейство по паттернам не пишется
+    auto empty = samples(exposition(ScanStatistics()));
+    EXPECT_EQ(empty["secret_detector_scan_files"], "0");
+    for (const auto& [key, value] : empty) {
+        EXPECT_EQ(key.find("pattern_matches"), std::string::npos);
+    }
+}
+
+TEST(MetricsWriter, EscapesLabelValues) {
+    EXPECT_EQ(MetricsWriter::escapeLabel("plain_name"), "plain_name");
+    EXPECT_EQ(MetricsWriter::escapeLabel("a\"b"), "a\\\"b");
+    EXPECT_EQ(MetricsWriter::escapeLabel("a\\b"), "a\\\\b");
+    EXPECT_EQ(MetricsWriter::escapeLabel("a\nb"), "a\\nb");
+    EXPECT_EQ(MetricsWriter::escapeLabel("\\n"), "\\\\n");
+
+    // экранированное имя паттерна - одна строка exposition
+    std::string text = exposition(sampleStatistics());
+    EXPECT_NE(text.find("secret_detector_scan_pattern_matches{pattern=\"weird\\\"na\\\\me\\nx\"} 1\n"),
+              std::string::npos);
+}
+
+class MetricsTextfileTest : public TestSupport::TempDirTest {};
+
+TEST_F(MetricsTextfileTest, WritesAtomically) {
+    std::string path = (dir / "secret_detector.prom").string();
+    ASSERT_TRUE(MetricsWriter::writeTextfile(sampleStatistics(), path));
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    EXPECT_EQ(samples(FileUtils::readFile(path))["secret_detector_scan_files"], "120");
+
+    EXPECT_FALSE(MetricsWriter::writeTextfile(sampleStatistics(), (dir / "missing/x.prom").string()));
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "utils/output_sink.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Целевой приемник для тестов: запоминает данные, может тормозить
+     * запись (gate) и сообщать об ошибке
+     */
+    class RecordingSink : public OutputSink {
+    public:
+        void write(const char* data, size_t size) override {
+            std::unique_lock<std::mutex> lock(mutex);
+            gate_cv.wait(lock, [this] { return open; });
+            buffer.append(data, size);
+            cv.notify_all();
+        }
+        using OutputSink::write;
+
+        void flush() override {
+            std::lock_guard<std::mutex> lock(mutex);
+            flushed = buffer.size();
+        }
+
+        bool failed() const override { return fail; }
+
+        /// Задержать запись до release() - медленный pipe
+        void hold() {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = false;
+        }
+
+        void release() {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+            gate_cv.notify_all();
+        }
+
+        /// Дождаться, пока в приемник придет не меньше size байт
+        bool waitFor(size_t size, std::chrono::milliseconds timeout) {
+            std::unique_lock<std::mutex> lock(mutex);
+            return cv.wait_for(lock, timeout, [&] { return buffer.size() >= size; });
+        }
+
+        std::string data() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return buffer;
+        }
+
+        size_t flushedBytes() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return flushed;
+        }
+
+        std::atomic<bool> fail{false};
+
+    private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::condition_variable gate_cv;
+        std::string buffer;
+        size_t flushed = 0;
+        bool open = true;
+    };
+
+    struct AsyncSinkTest : ::testing::Test {
+        RecordingSink* target = nullptr;
+
+        std::unique_ptr<AsyncSink> makeSink(size_t buffer_size) {
+            auto recording = std::make_unique<RecordingSink>();
+            target = recording.get();
+            return std::make_unique<AsyncSink>(std::move(recording), buffer_size);
+        }
+    };
+}
+
+TEST_F(AsyncSinkTest, KeepsOrderPerWriterAndWholeRecords) {
+    auto sink = makeSink(4096);
+    const int writers = 8;
+    const int records = 2000;
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < records; ++i) {
+                sink->write("w" + std::to_string(w) + ":" + std::to_string(i) + "\n");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    sink->close();
+
+    // каждая запись целиком, записи одного производителя - в порядке write()
+    std::map<int, int> next;
+    std::istringstream lines(target->data());
+    std::string line;
+    int total = 0;
+    while (std::getline(lines, line)) {
+        ASSERT_EQ(line[0], 'w') << line;
+        size_t colon = line.find(':');
+        ASSERT_NE(colon, std::string::npos) << line;
+        int w = std::stoi(line.substr(1, colon - 1));
+        int i = std::stoi(line.substr(colon + 1));
+        ASSERT_EQ(i, next[w]) << "writer " << w;
+        next[w] = i + 1;
+        ++total;
+    }
+    EXPECT_EQ(total, writers * records);
+    EXPECT_FALSE(sink->failed());
+}
+
+TEST_F(AsyncSinkTest, FlushDeliversWithoutFullBuffer) {
+    // блок намного больше данных: уходят только по flush() или таймеру
+    auto sink = makeSink(1024 * 1024);
+    const auto wait = std::chrono::milliseconds(AsyncSink::FLUSH_INTERVAL_MS);
+
+    sink->write("first finding\n");
+    auto start = Clock::now();
+    sink->flush();
+    ASSERT_TRUE(target->waitFor(14, 20 * wait));
+    // flush() будит писателя сразу; запас - на загруженную машину
+    EXPECT_LT(Clock::now() - start, 10 * wait);
+    EXPECT_EQ(target->data(), "first finding\n");
+
+    // без flush() данные уходят не позже интервала писателя
+    sink->write("second finding\n");
+    ASSERT_TRUE(target->waitFor(29, 20 * wait));
+    EXPECT_EQ(target->data(), "first finding\nsecond finding\n");
+    sink->close();
+    EXPECT_EQ(target->flushedBytes(), 29u);
+}
+
+TEST_F(AsyncSinkTest, SlowTargetBlocksProducers) {
+    const size_t capacity = 1024;
+    auto sink = makeSink(capacity);
+    target->hold();
+
+    const std::string chunk(100, 'x');
+    const size_t chunks = 1000;   // 100 KB - намного больше, чем может ждать в памяти
+    std::atomic<size_t> accepted{0};
+    std::thread producer([&] {
+        for (size_t i = 0; i < chunks; ++i) {
+            sink->write(chunk);
+            accepted += chunk.size();
+        }
+    });
+
+    // писатель взял один блок и висит в write(), производитель уперся в предел
+    std::this_thread::sleep_for(std::chrono::milliseconds(4 * AsyncSink::FLUSH_INTERVAL_MS));
+    size_t stalled = accepted.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * AsyncSink::FLUSH_INTERVAL_MS));
+    EXPECT_EQ(accepted.load(), stalled);
+    // в памяти: блок у писателя и не больше 4 блоков в очереди (плюс по записи сверху)
+    EXPECT_LE(stalled, 2 * (4 * capacity + chunk.size()));
+    EXPECT_LT(stalled, chunks * chunk.size());
+
+    target->release();
+    producer.join();
+    sink->close();
+    EXPECT_EQ(target->data(), std::string(chunks * chunk.size(), 'x'));
+}
+
+TEST_F(AsyncSinkTest, CloseDrainsEverything) {
+    auto sink = makeSink(64 * 1024);
+    std::string expected;
+    for (int i = 0; i < 10000; ++i) {
+        std::string record = "record " + std::to_string(i) + "\n";
+        sink->write(record);
+        expected += record;
+    }
+    sink->close();
+    EXPECT_EQ(target->data(), expected);
+    EXPECT_EQ(target->flushedBytes(), expected.size());
+
+    // после close() запись идет напрямую в целевой приемник
+    sink->write("tail\n");
+    EXPECT_EQ(target->data(), expected + "tail\n");
+    sink->close();
+    EXPECT_FALSE(sink->failed());
+}
+
+TEST_F(AsyncSinkTest, PropagatesTargetFailure) {
+    auto sink = makeSink(64 * 1024);
+    sink->write("ok\n");
+    sink->flush();
+    ASSERT_TRUE(target->waitFor(3, std::chrono::seconds(1)));
+    EXPECT_FALSE(sink->failed());
+
+    // ошибка целевого приемника видна после следующего блока писателя
+    target->fail = true;
+    sink->write("lost\n");
+    sink->flush();
+    ASSERT_TRUE(target->waitFor(8, std::chrono::seconds(1)));
+    sink->close();
+    EXPECT_TRUE(sink->failed());
+}
+
+TEST_F(AsyncSinkTest, PropagatesFailureAfterClose) {
+    auto sink = makeSink(64 * 1024);
+    sink->close();
+    EXPECT_FALSE(sink->failed());
+    target->fail = true;
+    sink->write("direct\n");
+    EXPECT_TRUE(sink->failed());
+}
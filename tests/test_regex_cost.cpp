@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "core/regex_cost.h"
+#include "core/pattern_matcher.h"
+#include "utils/config_manager.h"
+#include <chrono>
+
+namespace {
+    bool mentions(const std::vector<std::string>& messages, const std::string& text) {
+        for (const auto& message : messages) {
+            if (message.find(text) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    RegexCost analyze(const std::string& source, const RegexCostBudget& budget) {
+        std::regex regex(source, std::regex::icase | std::regex::ECMAScript);
+        return RegexCostAnalyzer::analyze(source, regex, {}, budget);
+    }
+
+    // бюджет с запасом: решение принимается по росту времени, а не по
+    // одному замеру, и не зависит от загрузки машины во время тестов
+    RegexCostBudget testBudget() {
+        RegexCostBudget budget;
+        budget.probe_budget_ms = 2000.0;
+        budget.slow_ns_per_byte = 1e9;
+        budget.total_budget_ms = 1e9;
+        return budget;
+    }
+}
+
+// структурная проверка
+
+TEST(RegexCostAnalyzer, FlagsNestedQuantifiers) {
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("(a+)+$"), "nested quantifier"));
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("(\\w+\\s?)*x"), "nested quantifier"));
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("(?:[a-z]*,){2,8}"), "nested quantifier"));
+    EXPECT_FALSE(mentions(RegexCostAnalyzer::structuralIssues("(ab?){3}c+"), "nested quantifier"));
+}
+
+TEST(RegexCostAnalyzer, FlagsAmbiguousAlternations) {
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("(a|aa)*b"), "ambiguous alternation"));
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("(x|\\w)+;"), "ambiguous alternation"));
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("(a|b?)+c"), "ambiguous alternation"));
+    EXPECT_FALSE(mentions(RegexCostAnalyzer::structuralIssues("(a|b)*c"), "ambiguous alternation"));
+    // альтернатива без повтора безопасна
+    EXPECT_TRUE(RegexCostAnalyzer::structuralIssues("(api_key|apikey)\\s*=").empty());
+}
+
+TEST(RegexCostAnalyzer, FlagsLeadingUnboundedQuantifier) {
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues(".*password"), "leading unbounded"));
+    EXPECT_TRUE(mentions(RegexCostAnalyzer::structuralIssues("\\s+token"), "leading unbounded"));
+    EXPECT_TRUE(RegexCostAnalyzer::structuralIssues("^.*password").empty());
+    EXPECT_TRUE(RegexCostAnalyzer::structuralIssues("token.*end").empty());
+}
+
+// пробы
+
+TEST(RegexCostAnalyzer, RejectsCatastrophicBacktracking) {
+    RegexCost nested = analyze("(a+)+$", testBudget());
+    EXPECT_TRUE(nested.rejected());
+    EXPECT_TRUE(mentions(nested.violations, "repeated 'a'"));
+    EXPECT_TRUE(mentions(nested.violations, "exponentially"));
+
+    RegexCost ambiguous = analyze("(a|aa)*b", testBudget());
+    EXPECT_TRUE(ambiguous.rejected());
+}
+
+TEST(RegexCostAnalyzer, SlowProbeWithoutGrowthOnlyWarns) {
+    // бюджет меньше любого замера: каждая проба "медленная", но рост
+    // линейный - это предупреждение, а не отказ
+    RegexCostBudget budget = testBudget();
+    budget.probe_budget_ms = 0.0;
+    RegexCost cost = analyze("token_[a-z0-9]{16}", budget);
+    EXPECT_FALSE(cost.rejected());
+    EXPECT_TRUE(mentions(cost.warnings, "budget 0.0 ms"));
+}
+
+TEST(RegexCostAnalyzer, QuadraticPatternStopsEarly) {
+    // .*literal квадратичен: предупреждение, проба останавливается на первом
+    // заметном росте и не доходит до max_probe_bytes
+    RegexCost cost = analyze(".*secret", testBudget());
+    EXPECT_FALSE(cost.rejected());
+    EXPECT_TRUE(mentions(cost.warnings, "leading unbounded"));
+    EXPECT_TRUE(mentions(cost.warnings, "superlinearly"));
+    EXPECT_FALSE(mentions(cost.warnings, "took"));
+}
+
+TEST(RegexCostAnalyzer, TotalBudgetStopsProbing) {
+    RegexCostBudget budget = testBudget();
+    budget.total_budget_ms = 0.0;
+    RegexCost cost = analyze("token_[a-z0-9]{16}", budget);
+    EXPECT_FALSE(cost.rejected());
+    EXPECT_TRUE(mentions(cost.warnings, "probing stopped"));
+}
+
+TEST(RegexCostAnalyzer, AcceptsLinearPatterns) {
+    RegexCost cost = analyze("token_[a-z0-9]{16}", testBudget());
+    EXPECT_FALSE(cost.rejected());
+    EXPECT_FALSE(mentions(cost.warnings, "nested quantifier"));
+    EXPECT_FALSE(mentions(cost.warnings, "took"));
+    EXPECT_FALSE(cost.worst_probe.empty());
+    EXPECT_GT(cost.worst_ns_per_byte, 0.0);
+}
+
+// загрузка паттернов
+
+TEST(RegexCostAnalyzer, BuiltinPatternsWithinBudget) {
+    PatternMatcher matcher;
+    ASSERT_TRUE(matcher.loadFromJson(ConfigManager::getDefaultPatterns()));
+    EXPECT_EQ(matcher.getPatternCount(), ConfigManager::getDefaultPatterns()["patterns"].size());
+
+    for (const auto& pattern : matcher.getPatterns()) {
+        if (pattern.use_entropy) {
+            continue;
+        }
+        EXPECT_TRUE(RegexCostAnalyzer::structuralIssues(pattern.regex_source).empty()) << pattern.name;
+    }
+}
+
+TEST(RegexCostAnalyzer, LoaderRejectsOverBudgetUnlessAllowed) {
+    json patterns;
+    patterns["patterns"]["nested"] = {{"regex", "(a+)+$"}, {"severity", "HIGH"}};
+    patterns["patterns"]["nested_allowed"] = {{"regex", "(b+)+$"}, {"severity", "HIGH"},
+                                              {"allow_slow", true}};
+    patterns["patterns"]["fine"] = {{"regex", "token_[a-z]{8}"}, {"severity", "HIGH"}};
+
+    PatternMatcher matcher;
+    matcher.setCostBudget(testBudget());
+    ASSERT_TRUE(matcher.loadFromJson(patterns));
+
+    std::vector<std::string> names;
+    for (const auto& pattern : matcher.getPatterns()) {
+        names.push_back(pattern.name);
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"fine", "nested_allowed"}));
+
+    RegexCostBudget disabled;
+    disabled.enabled = false;
+    matcher.setCostBudget(disabled);
+    ASSERT_TRUE(matcher.loadFromJson(patterns));
+    EXPECT_EQ(matcher.getPatternCount(), 3u);
+}
+
+TEST(RegexCostAnalyzer, QuadraticPatternLoadsQuickly) {
+    // бюджет по умолчанию: каждый запуск CLI, --serve и --watch платит за пробы
+    json patterns;
+    patterns["patterns"]["dotstar"] = {{"regex", ".*secret"}, {"severity", "HIGH"}};
+    patterns["patterns"]["dotstar_word"] = {{"regex", "\\s*.*password"}, {"severity", "HIGH"}};
+
+    PatternMatcher matcher;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(matcher.loadFromJson(patterns));
+    double elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(matcher.getPatternCount(), 2u);
+    // на паттерн - не больше total_budget_ms и одного шага сверх него
+    // (удвоение длины квадратичного regex - до 4 бюджетов пробы)
+    const RegexCostBudget budget;
+    EXPECT_LT(elapsed_ms, 2 * (budget.total_budget_ms + 4 * budget.probe_budget_ms));
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "core/scan_telemetry.h"
+#include <thread>
+#include <vector>
+
+namespace {
+    TelemetrySnapshot at(double elapsed, uint64_t files_done, uint64_t bytes_done,
+                         uint64_t files_total = 10, uint64_t bytes_total = 10000) {
+        TelemetrySnapshot snap;
+        snap.elapsed_seconds = elapsed;
+        snap.files_done = files_done;
+        snap.bytes_done = bytes_done;
+        snap.files_total = files_total;
+        snap.bytes_total = bytes_total;
+        return snap;
+    }
+
+    struct SamplerTest : ::testing::Test {
+        ScanTelemetry telemetry;
+        TelemetrySampler sampler{telemetry};
+    };
+}
+
+TEST(TelemetrySnapshot, PercentPrefersBytes) {
+    EXPECT_EQ(at(1, 5, 2500).percent(), 25);
+    // объем в байтах неизвестен - по файлам
+    EXPECT_EQ(at(1, 5, 2500, 10, 0).percent(), 50);
+    EXPECT_EQ(at(1, 5, 2500, 0, 0).percent(), 0);
+    EXPECT_EQ(at(1, 10, 10000).percent(), 100);
+    // файлы выросли после обхода
+    EXPECT_EQ(at(1, 10, 15000).percent(), 100);
+    EXPECT_EQ(at(1, 12, 0, 10, 0).percent(), 100);
+}
+
+TEST_F(SamplerTest, FirstSampleUsesAverageRate) {
+    TelemetrySnapshot snap = sampler.update(at(2.0, 4, 1000));
+    EXPECT_DOUBLE_EQ(snap.files_per_second, 2.0);
+    EXPECT_DOUBLE_EQ(snap.bytes_per_second, 500.0);
+    // ETA по байтам: (10000 - 1000) / 500
+    EXPECT_DOUBLE_EQ(snap.eta_seconds, 18.0);
+}
+
+TEST_F(SamplerTest, RateIsSmoothed) {
+    sampler.update(at(2.0, 4, 1000));     // 500 B/s
+
+    // мгновенная скорость 1500 B/s, сглаженная сдвигается на 30%
+    TelemetrySnapshot snap = sampler.update(at(3.0, 6, 2500));
+    EXPECT_DOUBLE_EQ(snap.bytes_per_second, 500.0 + 0.3 * (1500.0 - 500.0));
+    EXPECT_DOUBLE_EQ(snap.files_per_second, 2.0 + 0.3 * (2.0 - 2.0));
+    EXPECT_DOUBLE_EQ(snap.eta_seconds, 7500.0 / 800.0);
+
+    // одиночный всплеск не переносится в ETA целиком
+    snap = sampler.update(at(3.1, 7, 4500));   // 20000 B/s
+    EXPECT_LT(snap.bytes_per_second, 20000.0 / 2);
+    EXPECT_GT(snap.bytes_per_second, 800.0);
+
+    // повторный срез с тем же временем скорость не меняет
+    double rate = snap.bytes_per_second;
+    snap = sampler.update(at(3.1, 7, 4500));
+    EXPECT_DOUBLE_EQ(snap.bytes_per_second, rate);
+}
+
+TEST_F(SamplerTest, EtaIsNeverNegative) {
+    sampler.update(at(1.0, 1, 1000));
+
+    // застой: скорость затухает, ETA растет, но остается конечной
+    double previous_eta = 0.0;
+    for (int i = 2; i <= 10; ++i) {
+        TelemetrySnapshot snap = sampler.update(at(i, 1, 1000));
+        EXPECT_GT(snap.eta_seconds, previous_eta);
+        previous_eta = snap.eta_seconds;
+    }
+
+    // обработано больше, чем было при обходе
+    TelemetrySnapshot snap = sampler.update(at(11.0, 12, 12000));
+    EXPECT_DOUBLE_EQ(snap.eta_seconds, 0.0);
+
+    snap = at(12.0, 12, 12000);
+    snap.finished = true;
+    EXPECT_DOUBLE_EQ(sampler.update(snap).eta_seconds, 0.0);
+}
+
+TEST_F(SamplerTest, EtaUnknownWithoutTotals) {
+    // поток stdin: объем неизвестен
+    TelemetrySnapshot snap = sampler.update(at(1.0, 0, 4096, 0, 0));
+    EXPECT_DOUBLE_EQ(snap.bytes_per_second, 4096.0);
+    EXPECT_DOUBLE_EQ(snap.eta_seconds, -1.0);
+
+    // нет ни прогресса, ни времени
+    TelemetrySampler idle(telemetry);
+    EXPECT_DOUBLE_EQ(idle.update(at(0.0, 0, 0)).eta_seconds, -1.0);
+
+    // объем по файлам известен, по байтам нет
+    TelemetrySampler by_files(telemetry);
+    EXPECT_DOUBLE_EQ(by_files.update(at(2.0, 4, 0, 10, 0)).eta_seconds, 3.0);
+}
+
+TEST(ScanTelemetry, CountersFromWorkerThreads) {
+    ScanTelemetry telemetry;
+    EXPECT_DOUBLE_EQ(telemetry.snapshot().elapsed_seconds, 0.0);
+    telemetry.begin(4000, 4000 * 100);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&telemetry] {
+            for (int i = 0; i < 1000; ++i) {
+                telemetry.recordFile(100, i % 2);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    telemetry.recordBytes(50, 1);
+    telemetry.finish();
+
+    TelemetrySnapshot snap = telemetry.snapshot();
+    EXPECT_EQ(snap.files_done, 4000u);
+    EXPECT_EQ(snap.bytes_done, 4000u * 100 + 50);
+    EXPECT_EQ(snap.matches, 2001u);
+    EXPECT_EQ(snap.percent(), 100);
+    EXPECT_TRUE(snap.finished);
+    EXPECT_GE(snap.elapsed_seconds, 0.0);
+
+    TelemetrySampler sampler(telemetry);
+    EXPECT_DOUBLE_EQ(sampler.sample().eta_seconds, 0.0);
+}
@@ -0,0 +1,28 @@
+#include "test_support.h"
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace TestSupport {
+    void TempDirTest::SetUp() {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        dir = fs::temp_directory_path() /
+              ("sd_" + std::string(info->test_suite_name()) + "_" + info->name() + "_" +
+               std::to_string(::getpid()));
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+
+    void TempDirTest::TearDown() {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    fs::path TempDirTest::write(const std::string& name, const std::string& content) const {
+        fs::path path = dir / name;
+        fs::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+
+/**
+ * Общие помощники тестов (линкуются вместе с test_main.cpp в secretdetector_test_support)
+ */
+namespace TestSupport {
+    /**
+     * @class TempDirTest
+     * @brief Фикстура с временной директорией dir
+     *
+     * Директория своя у каждого теста и процесса (ctest -j запускает тесты
+     * параллельно): создается в SetUp, удаляется в TearDown. Наследники
+     * вызывают TempDirTest::SetUp() первым, а TempDirTest::TearDown() - последним.
+     */
+    class TempDirTest : public ::testing::Test {
+    protected:
+        std::filesystem::path dir;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        /**
+         * Записать файл (путь относительно dir, директории создаются)
+         * @return Полный путь файла
+         */
+        std::filesystem::path write(const std::string& name, const std::string& content) const;
+    };
+}
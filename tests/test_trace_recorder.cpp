@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "utils/trace_recorder.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <map>
+#include <set>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace {
+    std::string tracePath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() /
+                ("secret_detector_" + name + "_" + std::to_string(::getpid()) + ".json")).string();
+    }
+
+    json readTrace(const std::string& path) {
+        std::ifstream file(path);
+        json trace = json::parse(file);
+        std::filesystem::remove(path);
+        return trace;
+    }
+}
+
+TEST(TraceRecorder, DisabledScopeRecordsNothing) {
+    EXPECT_FALSE(TraceRecorder::enabled());
+    {
+        TRACE_SCOPE("ignored", "test");
+    }
+    TraceRecorder::start();
+    std::string path = tracePath("disabled");
+    ASSERT_TRUE(TraceRecorder::writeFile(path));
+    json trace = readTrace(path);
+    for (const auto& event : trace["traceEvents"]) {
+        EXPECT_NE(event["ph"], "X");
+    }
+}
+
+TEST(TraceRecorder, WritesSpansPerThread) {
+    TraceRecorder::start();
+    std::string file = "/very/long/path/that/does/not/fit/into/the/detail/field/of/an/event/secret.env";
+    {
+        TRACE_SCOPE_DETAIL("outer", "test", &file);
+        TRACE_SCOPE("inner", "test");
+    }
+    std::thread worker([]() {
+        TraceRecorder::setThreadName("scan worker");
+        TRACE_SCOPE("worker span", "test");
+    });
+    worker.join();
+
+    std::string path = tracePath("threads");
+    ASSERT_TRUE(TraceRecorder::writeFile(path));
+    EXPECT_FALSE(TraceRecorder::enabled());
+    json trace = readTrace(path);
+
+    std::set<std::string> thread_names;
+    std::map<std::string, json> spans;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "M") {
+            thread_names.insert(event["args"]["name"].get<std::string>());
+        } else {
+            spans[event["name"].get<std::string>()] = event;
+        }
+    }
+    EXPECT_EQ(thread_names, (std::set<std::string>{"main", "scan worker"}));
+    ASSERT_EQ(spans.size(), 3u);
+    EXPECT_EQ(spans["outer"]["tid"], spans["inner"]["tid"]);
+    EXPECT_NE(spans["outer"]["tid"], spans["worker span"]["tid"]);
+
+    // внутренний интервал лежит внутри внешнего
+    EXPECT_LE(spans["outer"]["ts"].get<double>(), spans["inner"]["ts"].get<double>());
+    EXPECT_GE(spans["outer"]["dur"].get<double>(), spans["inner"]["dur"].get<double>());
+
+    // путь обрезан слева: имя файла сохранилось
+    std::string detail = spans["outer"]["args"]["detail"];
+    EXPECT_LT(detail.size(), TraceEvent::DETAIL_SIZE);
+    EXPECT_EQ(detail.substr(0, 3), "...");
+    EXPECT_EQ(detail.substr(detail.size() - 10), "secret.env");
+}
+
+TEST(TraceRecorder, RingBufferKeepsNewestSpans) {
+    TraceRecorder::start(8);
+    for (int i = 0; i < 20; ++i) {
+        TraceRecorder::record(i < 12 ? "old" : "new", "test", i * 1000, i * 1000 + 500);
+    }
+    std::string path = tracePath("ring");
+    ASSERT_TRUE(TraceRecorder::writeFile(path));
+    json trace = readTrace(path);
+
+    size_t spans = 0;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            EXPECT_EQ(event["name"], "new");
+            ++spans;
+        }
+    }
+    EXPECT_EQ(spans, 8u);
+    EXPECT_EQ(trace["otherData"]["dropped_events"], 12);
+}